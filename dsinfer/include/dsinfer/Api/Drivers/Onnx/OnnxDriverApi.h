@@ -1,10 +1,16 @@
 #ifndef DSINFER_API_ONNX_ONNXDRIVERAPI_H
 #define DSINFER_API_ONNX_ONNXDRIVERAPI_H
 
+#include <chrono>
 #include <filesystem>
+#include <functional>
 #include <map>
+#include <memory>
+#include <optional>
 #include <set>
+#include <vector>
 
+#include <dsinfer/Core/CancellationToken.h>
 #include <dsinfer/Core/Tensor.h>
 #include <dsinfer/Inference/InferenceDriver.h>
 #include <dsinfer/Inference/InferenceSession.h>
@@ -22,6 +28,29 @@ namespace ds::Api::Onnx {
         CoreMLExecutionProvider,
     };
 
+    enum GraphOptimizationLevel {
+        NoGraphOptimization = 0,
+        BasicGraphOptimization,
+        ExtendedGraphOptimization,
+        AllGraphOptimization,
+    };
+
+    enum ExecutionMode {
+        SequentialExecution = 0,
+        ParallelExecution,
+    };
+
+    enum ShapeBucketing {
+        NoShapeBucketing = 0,
+        MultipleOfBucketing,
+        PowerOfTwoBucketing,
+    };
+
+    /// Receives the profiling trace of a model, in the Chrome trace event format that
+    /// chrome://tracing and Perfetto can open. It may be called from any thread.
+    using ProfilingSink = std::function<void(const std::filesystem::path &modelPath,
+                                             const std::filesystem::path &tracePath)>;
+
     class DriverInitArgs : public InferenceDriverInitArgs {
     public:
         inline DriverInitArgs() : InferenceDriverInitArgs(API_NAME, API_VERSION) {
@@ -35,6 +64,107 @@ namespace ds::Api::Onnx {
 
         /// The onnxruntime library directory. (empty means use the default)
         std::filesystem::path runtimePath;
+
+        /// The directory to cache the optimized models in, which saves the graph optimization
+        /// when a model is opened again in later processes. (empty means no cache)
+        std::filesystem::path cacheDirectory;
+
+        /// Whether all sessions share the global intra-op and inter-op thread pools of the
+        /// driver environment instead of creating their own.
+        bool useGlobalThreadPools = true;
+
+        /// The number of threads in the global intra-op thread pool. (0 means use the default)
+        int intraOpNumThreads = 0;
+
+        /// The number of threads in the global inter-op thread pool. (0 means use the default)
+        int interOpNumThreads = 0;
+
+        /// The logical processors (starting from 0) to pin the threads of the global intra-op
+        /// thread pool to, one processor per thread in turn. The thread calling a run counts
+        /// as the first thread of the pool and is pinned to the first processor during the
+        /// run. When intraOpNumThreads is 0, the pool has one thread per processor. (empty
+        /// means no pinning)
+        std::vector<int> intraOpCores;
+
+        /// Whether the global thread pool threads spin while waiting for work. Disabling it
+        /// lowers the CPU usage between runs at the cost of some latency.
+        bool allowSpinning = true;
+
+        /// Whether all sessions allocate from one CPU arena of the driver environment instead
+        /// of keeping their own.
+        bool shareCpuAllocator = true;
+
+        /// Whether the sessions of the same model share the weights prepacked for the CPU
+        /// kernels, e.g. when a model is opened with different hints or from different paths.
+        bool sharePrepackedWeights = true;
+
+        /// The estimated memory the loaded models may take, in bytes. When exceeded, the least
+        /// recently run models that no run is using are unloaded, and they are loaded again on
+        /// their next run. (0 means unlimited)
+        ///
+        /// A model is estimated by its file size.
+        uintmax_t residentMemoryBudget = 0;
+
+        /// The process resident memory in bytes above which the CPU memory arenas are shrunk.
+        /// When a run leaves the process above it, the loaded models that no run is using
+        /// return the CPU arena memory they do not use to the system. (0 means never shrink)
+        uintmax_t arenaShrinkThreshold = 0;
+
+        /// The time after which the CPU memory arenas of the models that have not run are
+        /// shrunk, once per idle period. The models stay loaded. (0 means never shrink)
+        ///
+        /// ORT only shrinks an arena at the end of a run, so a model is run once with the
+        /// smallest synthetic inputs to shrink it. With shareCpuAllocator, one such run shrinks
+        /// the shared CPU arena of all models.
+        std::chrono::milliseconds arenaIdleTimeout{0};
+
+        /// The directory to write the profiling traces of the profiled sessions into. (empty
+        /// means the working directory)
+        std::filesystem::path profilingDirectory;
+
+        /// Called when the trace of a profiled model has been written.
+        ProfilingSink profilingSink;
+    };
+
+    class DriverWarmUpArgs : public InferenceDriverWarmUpArgs {
+    public:
+        inline DriverWarmUpArgs() : InferenceDriverWarmUpArgs(API_NAME, API_VERSION) {
+        }
+
+        /// The length of the dynamic dimensions of the synthetic inputs, e.g. the number of
+        /// frames. Every model to warm up runs once with inputs of this length.
+        int64_t length = 256;
+
+        /// The paths of the models to warm up, usually those of one singer. (empty means all
+        /// the open models)
+        std::vector<std::filesystem::path> models;
+    };
+
+    class DriverStatistics : public InferenceDriverStatistics {
+    public:
+        inline DriverStatistics() : InferenceDriverStatistics(API_NAME, API_VERSION) {
+        }
+
+        /// The number of loaded models and their estimated memory in bytes.
+        size_t residentModels = 0;
+        uintmax_t residentMemory = 0;
+
+        /// The resident memory budget, 0 means unlimited.
+        uintmax_t residentMemoryBudget = 0;
+
+        /// The number of times models were unloaded for the budget, and loaded again.
+        uint64_t evictions = 0;
+        uint64_t reloads = 0;
+
+        /// The number of times the arenas of a model were shrunk for the arenaShrinkThreshold,
+        /// and for the arenaIdleTimeout.
+        uint64_t arenaShrinks = 0;
+        uint64_t idleShrinks = 0;
+
+        /// The memory given back to the system by them in bytes, measured by the drop of the
+        /// process resident memory across the shrinking runs, as ORT does not report the size
+        /// of its arenas.
+        uintmax_t reclaimedMemory = 0;
     };
 
     class SessionOpenArgs : public InferenceSessionOpenArgs {
@@ -44,6 +174,112 @@ namespace ds::Api::Onnx {
 
         /// Whether to force the use of the CPU for the session.
         bool useCpu = false;
+
+        /// The number of threads used to parallelize the execution within nodes. (0 means use
+        /// the default)
+        ///
+        /// A non-zero value makes the session create its own thread pools instead of sharing
+        /// the global ones of the driver.
+        int intraOpNumThreads = 0;
+
+        /// The number of threads used to parallelize the execution of the graph across nodes
+        /// in ParallelExecution mode. (0 means use the default)
+        ///
+        /// A non-zero value makes the session create its own thread pools instead of sharing
+        /// the global ones of the driver.
+        int interOpNumThreads = 0;
+
+        /// The logical processors (starting from 0) to pin the threads of the intra-op thread
+        /// pool of the session to, one processor per thread in turn, so that concurrent stages
+        /// can run on dedicated cores. When intraOpNumThreads is 0, the pool has one thread per
+        /// processor. (empty means no pinning)
+        ///
+        /// A non-empty value makes the session create its own thread pools instead of sharing
+        /// the global ones of the driver. The thread calling a run counts as the first thread
+        /// of the pool and is pinned to the first processor during the run.
+        ///
+        /// With replicas, the processors are split into one contiguous slice per replica, or
+        /// each replica is pinned to one processor in turn if there are fewer processors than
+        /// replicas. A replica left with a single processor runs on the calling thread alone
+        /// when intraOpNumThreads is 0.
+        std::vector<int> intraOpCores;
+
+        /// The graph optimization level applied when loading the model.
+        GraphOptimizationLevel graphOptimizationLevel = AllGraphOptimization;
+
+        /// Whether to execute the graph nodes sequentially or in parallel.
+        ExecutionMode executionMode = SequentialExecution;
+
+        /// Whether to pre-plan the memory allocation from the shapes of the previous run.
+        bool enableMemPattern = true;
+
+        /// Whether the session threads spin while waiting for work. Only takes effect when the
+        /// session owns its thread pools.
+        bool allowSpinning = true;
+
+        /// How to round up the bucketed dimensions of the inputs, so that the runs of similar
+        /// lengths share the same shapes and ORT does not re-plan the memory for every run.
+        ///
+        /// The inputs are padded by repeating their last element along the bucketed axes, and
+        /// the outputs are trimmed back: axes with a bucketed dimension are cut to the original
+        /// length, and other dynamic axes that scaled with the padding (e.g. samples of a
+        /// vocoder) are cut in proportion. Only use it with models whose outputs within the
+        /// original range are not affected by the padded tail.
+        ShapeBucketing shapeBucketing = NoShapeBucketing;
+
+        /// The bucket granularity of MultipleOfBucketing, or the smallest bucket of
+        /// PowerOfTwoBucketing.
+        int64_t bucketSize = 256;
+
+        /// The symbolic dimension names of the model inputs to bucket, e.g. "n_frames".
+        std::set<std::string> bucketedDimensions;
+
+        /// Whether to create the session from a memory mapping of the model file instead of
+        /// reading it into the heap.
+        ///
+        /// The optimized models in the cache directory are used in place, so the processes
+        /// loading the same model share its weights through the page cache. ONNX models are
+        /// still parsed into private memory, and those with external data are loaded from the
+        /// file instead.
+        bool memoryMapModel = false;
+
+        /// Whether to keep the output buffers of the session in a pool for later runs.
+        ///
+        /// The outputs whose shapes can be inferred from the input shapes are written straight
+        /// into pooled buffers, which return to the pool when the result tensors are released.
+        /// Only applies to synchronous runs.
+        bool reuseOutputBuffers = false;
+
+        /// Whether to profile the runs of the model with the ORT profiler, which records the
+        /// time of every run and every node within it.
+        ///
+        /// The trace covers all runs since the model was loaded, and is written when the model
+        /// is unloaded or its last session is closed. It is then passed to the profiling sink
+        /// of the driver. Without a residentMemoryBudget the model is never unloaded, so the
+        /// trace only arrives when its last session is closed, not after each run.
+        bool enableProfiling = false;
+
+        /// The number of independent sessions of the model to dispatch the runs to, each run
+        /// going to an idle one. Concurrent runs of a small model scale better on replicas with
+        /// one or two threads each than on one session with many threads, so it is best used
+        /// with a small intraOpNumThreads on the CPU execution provider.
+        ///
+        /// The replicas are loaded and unloaded together, and each takes the memory of the
+        /// model, apart from the weights shared by sharePrepackedWeights.
+        int replicas = 1;
+    };
+
+    class SessionBindingPlan : public InferenceSessionBindingPlan {
+    public:
+        inline SessionBindingPlan() : InferenceSessionBindingPlan(API_NAME, API_VERSION) {
+        }
+
+        /// The input port names in the order of the input slots, which cover every input of
+        /// the model.
+        std::vector<std::string> inputs;
+
+        /// The output port names in the order of the output slots.
+        std::vector<std::string> outputs;
     };
 
     class SessionStartInput : public InferenceSessionStartInput {
@@ -56,6 +292,33 @@ namespace ds::Api::Onnx {
 
         /// The output port names.
         std::set<std::string> outputs;
+
+        /// The output tensors to write the results into, which must have the exact shapes of
+        /// the outputs. The same tensors are returned in the result. Only applies to
+        /// synchronous runs.
+        std::map<std::string, srt::NO<ITensor>> outputBuffers;
+
+        /// Whether to copy the "tensor" backend inputs into ORT-owned buffers before running.
+        /// When false, the session binds the tensor buffers directly and holds a reference to
+        /// each buffer until the run completes, so the inputs must not be modified meanwhile.
+        /// Releasing an input, or a clone of it, during the run is safe.
+        bool copyInputs = false;
+
+        /// The token to cancel this run with. Cancelling it terminates only this run, and the
+        /// run fails with a cancellation error.
+        std::shared_ptr<CancellationToken> cancellationToken;
+
+        /// The time by which the run must finish, otherwise it is terminated and fails with a
+        /// deadline error.
+        std::optional<std::chrono::steady_clock::time_point> deadline;
+
+        /// The binding plan created by the session to run with. When set, the input tensors
+        /// are taken from \c inputSlots in the order of the plan, and \c inputs and \c outputs
+        /// are ignored. The outputs are returned in \c outputSlots of the result.
+        srt::NO<SessionBindingPlan> bindingPlan;
+
+        /// The input tensors in the order of the input slots of the binding plan.
+        std::vector<srt::NO<ITensor>> inputSlots;
     };
 
     class SessionResult : public InferenceSessionResult {
@@ -64,6 +327,10 @@ namespace ds::Api::Onnx {
         }
 
         std::map<std::string, srt::NO<ITensor>> outputs;
+
+        /// The output tensors in the order of the output slots of the binding plan, which is
+        /// filled instead of \c outputs when the run uses a plan.
+        std::vector<srt::NO<ITensor>> outputSlots;
     };
 
 }
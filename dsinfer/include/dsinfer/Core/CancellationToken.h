@@ -0,0 +1,50 @@
+#ifndef DSINFER_CANCELLATIONTOKEN_H
+#define DSINFER_CANCELLATIONTOKEN_H
+
+#include <functional>
+#include <memory>
+
+#include <dsinfer/dsinfer_global.h>
+
+namespace ds {
+
+    /// CancellationToken - Requests the cancellation of the tasks it is passed to.
+    ///
+    /// A token is shared by the requester and the tasks, and the tasks register callbacks to
+    /// abort their work when the token is cancelled. Cancelling is permanent.
+    class DSINFER_EXPORT CancellationToken {
+    public:
+        using Callback = std::function<void()>;
+
+        CancellationToken();
+        ~CancellationToken();
+
+        CancellationToken(const CancellationToken &) = delete;
+        CancellationToken &operator=(const CancellationToken &) = delete;
+
+    public:
+        /// Cancels the token and invokes the registered callbacks. Does nothing if the token has
+        /// been cancelled.
+        void cancel();
+
+        bool isCancelled() const;
+
+        /// Registers a callback to be invoked on cancellation, and returns its id for
+        /// unsubscribing. If the token has been cancelled, the callback is invoked immediately
+        /// and 0 is returned.
+        ///
+        /// \note The callbacks must not call back into the token.
+        int subscribe(Callback callback);
+
+        /// Unregisters a callback. Once it returns, the callback is not running and will not be
+        /// invoked.
+        void unsubscribe(int id);
+
+    protected:
+        class Impl;
+        std::unique_ptr<Impl> _impl;
+    };
+
+}
+
+#endif // DSINFER_CANCELLATIONTOKEN_H
@@ -0,0 +1,167 @@
+#ifndef DSINFER_FLOAT16_H
+#define DSINFER_FLOAT16_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <dsinfer/dsinfer_global.h>
+
+namespace ds {
+
+    namespace detail {
+
+        inline uint32_t floatBits(float value) {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        inline float floatFromBits(uint32_t bits) {
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+    }
+
+    /// Float16 - IEEE 754 half-precision floating point storage type.
+    ///
+    /// Only stores the bits, arithmetic should be done after converting to \c float.
+    struct Float16 {
+        uint16_t bits = 0;
+
+        Float16() = default;
+
+        /// Converts a float with round-to-nearest-even.
+        explicit Float16(float value) : bits(fromFloat(value)) {
+        }
+
+        explicit operator float() const {
+            return toFloat(bits);
+        }
+
+        static constexpr Float16 fromBits(uint16_t bits) {
+            Float16 value;
+            value.bits = bits;
+            return value;
+        }
+
+        friend bool operator==(Float16 a, Float16 b) {
+            return a.bits == b.bits;
+        }
+
+        friend bool operator!=(Float16 a, Float16 b) {
+            return a.bits != b.bits;
+        }
+
+        static inline uint16_t fromFloat(float value) {
+            uint32_t x = detail::floatBits(value);
+            const uint32_t sign = (x >> 16) & 0x8000;
+            x &= 0x7FFFFFFF;
+
+            // Infinity or NaN, keeping NaNs quiet
+            if (x >= 0x7F800000) {
+                return uint16_t(sign | 0x7C00 | (x > 0x7F800000 ? 0x200 | ((x >> 13) & 0x3FF) : 0));
+            }
+            // Too large, rounds to infinity
+            if (x >= 0x477FF000) {
+                return uint16_t(sign | 0x7C00);
+            }
+            // Normal numbers, rebias the exponent and round the mantissa
+            if (x >= 0x38800000) {
+                uint32_t h = (x - 0x38000000) >> 13;
+                const uint32_t rem = x & 0x1FFF;
+                if (rem > 0x1000 || (rem == 0x1000 && (h & 1))) {
+                    h++;
+                }
+                return uint16_t(sign | h);
+            }
+            // Too small, rounds to zero
+            if (x < 0x33000000) {
+                return uint16_t(sign);
+            }
+            // Subnormal numbers, in units of 2^-24
+            const uint32_t m = (x & 0x7FFFFF) | 0x800000;
+            const uint32_t shift = 126 - (x >> 23);
+            uint32_t h = m >> shift;
+            const uint32_t rem = m & ((1u << shift) - 1);
+            const uint32_t half = 1u << (shift - 1);
+            if (rem > half || (rem == half && (h & 1))) {
+                h++;
+            }
+            return uint16_t(sign | h);
+        }
+
+        static inline float toFloat(uint16_t h) {
+            const uint32_t sign = uint32_t(h & 0x8000) << 16;
+            const uint32_t exponent = (h >> 10) & 0x1F;
+            const uint32_t mantissa = h & 0x3FF;
+            if (exponent == 0) {
+                // Zero or subnormal, exact in float
+                const float value = float(mantissa) * 5.9604644775390625e-8f; // 2^-24
+                return detail::floatFromBits(sign | detail::floatBits(value));
+            }
+            if (exponent == 0x1F) {
+                // Infinity or NaN, keeping NaNs quiet
+                return detail::floatFromBits(sign | 0x7F800000 | (mantissa << 13) |
+                                             (mantissa ? 0x400000 : 0));
+            }
+            return detail::floatFromBits(sign | ((exponent + 112) << 23) | (mantissa << 13));
+        }
+    };
+
+    /// BFloat16 - Brain floating point storage type, the upper half of a \c float.
+    struct BFloat16 {
+        uint16_t bits = 0;
+
+        BFloat16() = default;
+
+        /// Converts a float with round-to-nearest-even.
+        explicit BFloat16(float value) : bits(fromFloat(value)) {
+        }
+
+        explicit operator float() const {
+            return toFloat(bits);
+        }
+
+        static constexpr BFloat16 fromBits(uint16_t bits) {
+            BFloat16 value;
+            value.bits = bits;
+            return value;
+        }
+
+        friend bool operator==(BFloat16 a, BFloat16 b) {
+            return a.bits == b.bits;
+        }
+
+        friend bool operator!=(BFloat16 a, BFloat16 b) {
+            return a.bits != b.bits;
+        }
+
+        static inline uint16_t fromFloat(float value) {
+            const uint32_t x = detail::floatBits(value);
+            if ((x & 0x7FFFFFFF) > 0x7F800000) {
+                return uint16_t((x >> 16) | 0x40); // quiet NaN
+            }
+            return uint16_t((x + 0x7FFF + ((x >> 16) & 1)) >> 16);
+        }
+
+        static inline float toFloat(uint16_t bits) {
+            return detail::floatFromBits(uint32_t(bits) << 16);
+        }
+    };
+
+    static_assert(sizeof(Float16) == 2 && sizeof(BFloat16) == 2);
+
+    /// Bulk conversions between \c float and the half-precision types. They use the hardware
+    /// conversion instructions when the build enables them (F16C on x86, NEON on ARM64), and
+    /// give the same results as the scalar conversions otherwise.
+    DSINFER_EXPORT void convertFloatToFloat16(const float *src, Float16 *dst, size_t count);
+    DSINFER_EXPORT void convertFloat16ToFloat(const Float16 *src, float *dst, size_t count);
+    DSINFER_EXPORT void convertFloatToBFloat16(const float *src, BFloat16 *dst, size_t count);
+    DSINFER_EXPORT void convertBFloat16ToFloat(const BFloat16 *src, float *dst, size_t count);
+
+}
+
+#endif // DSINFER_FLOAT16_H
@@ -3,7 +3,9 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -12,6 +14,8 @@
 #include <synthrt/Core/NamedObject.h>
 #include <synthrt/Support/Expected.h>
 
+#include <dsinfer/Core/Float16.h>
+#include <dsinfer/Core/TensorBufferPool.h>
 #include <dsinfer/Support/AlignedAllocator.h>
 #include <dsinfer/dsinfer_global.h>
 
@@ -26,6 +30,8 @@ namespace ds {
             Float = 1,
             Bool = 2,
             Int64 = 3,
+            Float16 = 4,
+            BFloat16 = 5,
             // Note: after adding new types here, please register type traits using
             // DSINFER_TENSOR_REGISTER_DATATYPE(_CppType, _EnumType) macro (see below)
         };
@@ -50,6 +56,27 @@ namespace ds {
         /// Get the size in bytes of a single element in the tensor.
         virtual size_t elementSize() const = 0;
 
+        /// Get the strides of the tensor in elements, i.e. the distance between adjacent
+        /// elements along each axis. The default implementation returns the strides of a
+        /// contiguous row-major tensor.
+        virtual std::vector<int64_t> strides() const {
+            auto dims = shape();
+            std::vector<int64_t> result(dims.size());
+            int64_t stride = 1;
+            for (size_t i = dims.size(); i > 0; --i) {
+                result[i - 1] = stride;
+                stride *= dims[i - 1];
+            }
+            return result;
+        }
+
+        /// Check whether the elements are stored contiguously in row-major order. Only then
+        /// rawView() and view() cover the elements, otherwise they are empty and the elements
+        /// must be addressed from rawData() by strides().
+        virtual bool isContiguous() const {
+            return true;
+        }
+
         /// Get a const pointer to the raw data inside the tensor.
         virtual const std::byte *rawData() const = 0;
 
@@ -59,6 +86,25 @@ namespace ds {
         /// Get a view over the raw tensor bytes.
         virtual stdc::array_view<std::byte> rawView() const = 0;
 
+        /// Get the alignment in bytes of the raw data, a power of two. The default
+        /// implementation returns the largest power of two that the address is a multiple of,
+        /// up to 4096.
+        virtual size_t alignment() const {
+            constexpr size_t maxAlignment = 4096;
+            auto address = reinterpret_cast<uintptr_t>(rawData());
+            if (address == 0) {
+                return maxAlignment;
+            }
+            // The lowest set bit of the address
+            return std::min(static_cast<size_t>(address & (~address + 1)), maxAlignment);
+        }
+
+        /// Check whether the raw data is aligned to \a alignment bytes, a power of two, e.g. to
+        /// take the aligned SIMD path of a kernel.
+        inline bool isAligned(size_t alignment) const {
+            return this->alignment() >= alignment;
+        }
+
         /// Get a typed const pointer to element data.
         /// \tparam T  C++ element type. Must match dataType().
         /// \return nullptr if T does not match dataType(), otherwise pointer to the first element.
@@ -73,11 +119,13 @@ namespace ds {
 
         /// Typed view over element data.
         /// \tparam T C++ element type. Must match dataType().
-        /// \return stdc::array_view<T> of length elementCount(), empty if type mismatch.
+        /// \return stdc::array_view<T> of length elementCount(), empty if type mismatch or the
+        ///         tensor is not contiguous.
         template <typename T>
         stdc::array_view<T> view() const;
 
-        /// Create a deep copy of this tensor as an ITensor object.
+        /// Create a copy of this tensor as an ITensor object, which does not change when this
+        /// tensor is written to, and vice versa.
         virtual srt::NO<ITensor> clone() const = 0;
     };
 
@@ -103,6 +151,8 @@ namespace ds {
     DSINFER_TENSOR_REGISTER_DATATYPE(float, Float)
     DSINFER_TENSOR_REGISTER_DATATYPE(int64_t, Int64)
     DSINFER_TENSOR_REGISTER_DATATYPE(bool, Bool)
+    DSINFER_TENSOR_REGISTER_DATATYPE(ds::Float16, Float16)
+    DSINFER_TENSOR_REGISTER_DATATYPE(ds::BFloat16, BFloat16)
 
 #undef DSINFER_TENSOR_REGISTER_DATATYPE
 
@@ -133,7 +183,7 @@ namespace ds {
         static_assert(tensor_traits<T>::is_valid, "Unsupported tensor data type");
         static_assert(!std::is_same_v<T, bool> || sizeof(bool) == 1,
                       "sizeof(bool) == 1 does not satisfy");
-        if (tensor_traits<T>::data_type != dataType()) {
+        if (tensor_traits<T>::data_type != dataType() || !isContiguous()) {
             return stdc::array_view<T>();
         }
         return {reinterpret_cast<const T *>(rawData()), elementCount()};
@@ -143,15 +193,22 @@ namespace ds {
     /// Tensor - CPU-based tensor implementation.
     ///
     /// This implementation uses a \c std::vector<std::byte> to store the tensor data,
-    /// with alignment requirements to ensure proper memory access.
+    /// with alignment requirements to ensure proper memory access. The buffers are drawn from
+    /// \c TensorBufferPool, and return to it when the tensor is destroyed. Clones share the
+    /// buffer by reference count, and copy it when written to.
     class DSINFER_EXPORT Tensor : public ITensor {
     public:
-        static constexpr size_t ALIGNMENT = sizeof(int64_t);
+        /// The alignment of the tensor buffers, set by the \c DSINFER_TENSOR_ALIGNMENT build
+        /// option.
+        static constexpr size_t ALIGNMENT = DSINFER_TENSOR_ALIGNMENT;
+
+        static_assert(ALIGNMENT >= sizeof(int64_t) && (ALIGNMENT & (ALIGNMENT - 1)) == 0,
+                      "DSINFER_TENSOR_ALIGNMENT must be a power of two of at least 8");
 
         template <typename T>
         using AlignedVector = std::vector<T, AlignedAllocator<T, ALIGNMENT>>;
 
-        using Container = AlignedVector<std::byte>;
+        using Container = std::vector<std::byte, TensorBufferAllocator<std::byte, ALIGNMENT>>;
 
         /// Tensor backend identifier.
         static constexpr const char *BACKEND = "tensor";
@@ -180,6 +237,20 @@ namespace ds {
         static srt::Expected<srt::NO<Tensor>> create(DataType dataType,
                                                      const std::vector<int64_t> &shape);
 
+        /// \brief Allocates a new tensor without initializing its elements.
+        ///
+        /// Saves the zero-fill of \c create() when the caller writes every element anyway.
+        ///
+        /// \param dataType The data type of each element in the tensor.
+        /// \param shape A vector representing the shape (dimensions) of the tensor.
+        ///
+        /// \return On success: A new Tensor wrapped in `srt::NO`.
+        ///         On failure: An error describing the cause of the failure.
+        ///
+        /// \note The contents of the returned tensor are indeterminate.
+        static srt::Expected<srt::NO<Tensor>>
+            createUninitialized(DataType dataType, const std::vector<int64_t> &shape);
+
         /// \brief Create a tensor from raw byte data.
         ///
         /// The tensor makes an internal copy of the provided data.
@@ -308,19 +379,33 @@ namespace ds {
         const std::byte *rawData() const override;
 
         /// \copydoc ITensor::mutableRawData
+        /// \note If the buffer is shared with clones, the tensor takes a copy of it first, so
+        ///       pointers obtained before cloning must not be written through afterwards.
         std::byte *mutableRawData() override;
 
         /// \copydoc ITensor::rawView
         stdc::array_view<std::byte> rawView() const override;
 
+        /// \copydoc ITensor::alignment
+        /// \note Returns at least \c ALIGNMENT, even for an empty tensor.
+        size_t alignment() const override;
+
         /// \copydoc ITensor::clone
         /// \post After cloning, the underlying backend remains the same.
+        /// \note The clone shares the buffer until either of them calls mutableRawData(), so
+        ///       cloning takes constant time. Tensors sharing a buffer may be used on different
+        ///       threads, but clone() and mutableRawData() must not be called on the same tensor
+        ///       at once.
         srt::NO<ITensor> clone() const override;
 
+        /// Check whether the buffer is shared with clones, in which case the next call to
+        /// mutableRawData() copies it.
+        bool isShared() const;
+
     protected:
         DataType _dataType;
         std::vector<int64_t> _shape;
-        Container _data;
+        std::shared_ptr<Container> _data;
     };
 
     inline Tensor::Tensor(Tensor &&other) noexcept
@@ -377,7 +462,7 @@ namespace ds {
         static_assert(!std::is_same_v<T, bool> || sizeof(bool) == 1,
                       "sizeof(bool) == 1 does not satisfy");
 
-        auto exp = create(tensor_traits<T>::data_type, shape);
+        auto exp = createUninitialized(tensor_traits<T>::data_type, shape);
         if (!exp) {
             return exp.takeError();
         }
@@ -0,0 +1,183 @@
+#ifndef DSINFER_TENSORBUFFERPOOL_H
+#define DSINFER_TENSORBUFFERPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dsinfer/Support/AlignedAllocator.h>
+#include <dsinfer/dsinfer_global.h>
+
+namespace ds {
+
+    /// TensorBufferPool - Process-wide pool of the buffers of \c Tensor.
+    ///
+    /// The buffers are rounded up to size classes, four per power of two, and the freed ones
+    /// are kept per size class for the next allocations of the same class. The pool is
+    /// thread-safe. Buffers larger than \c MAX_BLOCK_SIZE, or freed when the pool holds its
+    /// capacity, go straight back to the system.
+    class DSINFER_EXPORT TensorBufferPool {
+    public:
+        /// The alignment of every pooled buffer, at least a cache line.
+        static constexpr size_t ALIGNMENT =
+            DSINFER_TENSOR_ALIGNMENT > 64 ? DSINFER_TENSOR_ALIGNMENT : 64;
+
+        /// The smallest and largest pooled buffer sizes.
+        static constexpr size_t MIN_BLOCK_SIZE = size_t(1) << 6;
+        static constexpr size_t MAX_BLOCK_SIZE = size_t(1) << 26;
+
+        struct SizeClassStatistics {
+            /// The size of the buffers of the class.
+            size_t blockSize = 0;
+
+            /// The number of free buffers held.
+            size_t cachedBlocks = 0;
+
+            /// The number of allocations served from the held buffers, and from the system.
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+        };
+
+        struct Statistics {
+            /// The total size of the free buffers held, and the limit of it.
+            size_t cachedBytes = 0;
+            size_t capacity = 0;
+
+            /// The totals of all size classes. Allocations over \c MAX_BLOCK_SIZE count as
+            /// misses.
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+
+            /// The size classes that have been used.
+            std::vector<SizeClassStatistics> sizeClasses;
+        };
+
+        /// Allocates a buffer of at least \a size bytes aligned to \c ALIGNMENT.
+        ///
+        /// \throw std::bad_alloc if out of memory.
+        static void *allocate(size_t size);
+
+        /// Returns a buffer to the pool. \a size must be the size it was allocated with.
+        static void deallocate(void *ptr, size_t size) noexcept;
+
+        /// Sets the largest total size of the free buffers to hold, and frees the buffers over
+        /// it. The default is 256 MiB, 0 disables pooling.
+        static void setCapacity(size_t bytes);
+        static size_t capacity();
+
+        /// Frees all the held buffers. Returns the number of bytes freed.
+        static size_t trim();
+
+        static Statistics statistics();
+    };
+
+    /// TensorBufferAllocator - Allocator drawing from \c TensorBufferPool.
+    ///
+    /// Alignments over \c TensorBufferPool::ALIGNMENT are not pooled. Elements constructed
+    /// without arguments are value-initialized as usual, unless the container was given the
+    /// allocator returned by \c uninitialized(), in which case sizing it, e.g. \c resize(n),
+    /// leaves trivial elements uninitialized.
+    template <typename T, std::size_t Alignment>
+    class TensorBufferAllocator {
+    public:
+        using value_type = T;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using reference = T &;
+        using const_reference = const T &;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        using propagate_on_container_move_assignment = std::true_type;
+        using is_always_equal = std::true_type;
+
+        static constexpr bool pooled = Alignment <= TensorBufferPool::ALIGNMENT;
+
+        TensorBufferAllocator() noexcept = default;
+
+        template <typename U>
+        TensorBufferAllocator(const TensorBufferAllocator<U, Alignment> &other) noexcept
+            : _defaultInit(other._defaultInit) {
+        }
+
+        /// Returns an allocator that default-initializes the elements constructed without
+        /// arguments. Copies of a container made with it value-initialize again.
+        static TensorBufferAllocator uninitialized() noexcept {
+            TensorBufferAllocator allocator;
+            allocator._defaultInit = true;
+            return allocator;
+        }
+
+        TensorBufferAllocator select_on_container_copy_construction() const noexcept {
+            return {};
+        }
+
+        [[nodiscard]]
+        T *allocate(size_type n) {
+            if constexpr (pooled) {
+                if (n > max_size()) {
+                    throw std::bad_alloc();
+                }
+                return static_cast<T *>(TensorBufferPool::allocate(n * sizeof(T)));
+            } else {
+                return AlignedAllocator<T, Alignment>().allocate(n);
+            }
+        }
+
+        void deallocate(T *p, size_type n) noexcept {
+            if constexpr (pooled) {
+                TensorBufferPool::deallocate(p, n * sizeof(T));
+            } else {
+                AlignedAllocator<T, Alignment>().deallocate(p, n);
+            }
+        }
+
+        size_type max_size() const noexcept {
+            return std::numeric_limits<size_type>::max() / sizeof(T);
+        }
+
+        template <typename U>
+        void construct(U *p) noexcept(std::is_nothrow_default_constructible_v<U>) {
+            if (_defaultInit) {
+                ::new (static_cast<void *>(p)) U;
+            } else {
+                ::new (static_cast<void *>(p)) U();
+            }
+        }
+
+        template <typename U, typename... Args>
+        void construct(U *p, Args &&...args) {
+            ::new (static_cast<void *>(p)) U(std::forward<Args>(args)...);
+        }
+
+        template <typename U>
+        struct rebind {
+            using other = TensorBufferAllocator<U, Alignment>;
+        };
+
+    private:
+        template <typename U, std::size_t A>
+        friend class TensorBufferAllocator;
+
+        bool _defaultInit = false;
+    };
+
+    template <typename T1, std::size_t A1, typename T2, std::size_t A2>
+    constexpr bool operator==(const TensorBufferAllocator<T1, A1> &,
+                              const TensorBufferAllocator<T2, A2> &) noexcept {
+        return A1 == A2;
+    }
+
+    template <typename T1, std::size_t A1, typename T2, std::size_t A2>
+    constexpr bool operator!=(const TensorBufferAllocator<T1, A1> &a,
+                              const TensorBufferAllocator<T2, A2> &b) noexcept {
+        return !(a == b);
+    }
+
+}
+
+#endif // DSINFER_TENSORBUFFERPOOL_H
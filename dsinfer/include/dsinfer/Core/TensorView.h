@@ -0,0 +1,99 @@
+#ifndef DSINFER_TENSORVIEW_H
+#define DSINFER_TENSORVIEW_H
+
+#include <dsinfer/Core/Tensor.h>
+
+namespace ds {
+
+    /// TensorView - Strided view over the elements of another tensor.
+    ///
+    /// A view shares the ownership of the tensor it is taken from, and refers to its elements
+    /// in place by an offset, a shape and strides, so slicing never copies. Writing through a
+    /// view writes to the viewed tensor.
+    ///
+    /// \note \c rawData() points at the first element of the view, and \c byteSize() is the
+    ///       size of its elements. A view that is not contiguous has an empty \c rawView().
+    class DSINFER_EXPORT TensorView : public ITensor {
+    public:
+        /// Tensor backend identifier.
+        static constexpr const char *BACKEND = "view";
+
+        /// Default constructor, creates an empty/invalid view.
+        inline TensorView() : ITensor(), _offset(0) {
+        }
+
+        ~TensorView() override = default;
+
+        /// \brief Creates a view over all elements of a tensor.
+        ///
+        /// A view of a view refers to the tensor of the latter directly.
+        ///
+        /// \return On success: A new TensorView wrapped in `srt::NO`.
+        ///         On failure: An error describing the cause of the failure.
+        static srt::Expected<srt::NO<TensorView>> create(const srt::NO<ITensor> &tensor);
+
+        /// \brief Creates a view of the range [begin, end) along an axis.
+        ///
+        /// \param axis The axis to slice, less than the rank of the view.
+        /// \param begin The first index, negative values count from the end.
+        /// \param end The index past the last, negative values count from the end.
+        ///
+        /// \return On success: A new TensorView over the same tensor wrapped in `srt::NO`.
+        ///         On failure: An error describing the cause of the failure.
+        ///
+        /// \pre The range must not be empty after counting from the end.
+        srt::Expected<srt::NO<TensorView>> slice(size_t axis, int64_t begin, int64_t end) const;
+
+        /// Get the tensor that the view refers to.
+        srt::NO<ITensor> base() const;
+
+        /// Get the index of the first element of the view within the base tensor.
+        int64_t offset() const;
+
+        /// \copydoc ITensor::backend
+        std::string backend() const override;
+
+        /// \copydoc ITensor::dataType
+        DataType dataType() const override;
+
+        /// \copydoc ITensor::shape
+        std::vector<int64_t> shape() const override;
+
+        /// \copydoc ITensor::byteSize
+        size_t byteSize() const override;
+
+        /// \copydoc ITensor::elementCount
+        size_t elementCount() const override;
+
+        /// \copydoc ITensor::elementSize
+        size_t elementSize() const override;
+
+        /// \copydoc ITensor::strides
+        std::vector<int64_t> strides() const override;
+
+        /// \copydoc ITensor::isContiguous
+        bool isContiguous() const override;
+
+        /// \copydoc ITensor::rawData
+        const std::byte *rawData() const override;
+
+        /// \copydoc ITensor::mutableRawData
+        std::byte *mutableRawData() override;
+
+        /// \copydoc ITensor::rawView
+        stdc::array_view<std::byte> rawView() const override;
+
+        /// \copydoc ITensor::clone
+        /// \post The copy is a contiguous \c Tensor, which no longer refers to the base tensor.
+        srt::NO<ITensor> clone() const override;
+
+    protected:
+        srt::NO<ITensor> _base;
+        int64_t _offset;
+        std::vector<int64_t> _shape;
+        std::vector<int64_t> _strides;
+    };
+
+}
+
+#endif // DSINFER_TENSORVIEW_H
@@ -16,6 +16,24 @@ namespace ds {
         int version;
     };
 
+    class InferenceDriverStatistics : public srt::NamedObject {
+    public:
+        inline InferenceDriverStatistics(std::string name, int version)
+            : srt::NamedObject(std::move(name)), version(version) {
+        }
+
+        int version;
+    };
+
+    class InferenceDriverWarmUpArgs : public srt::NamedObject {
+    public:
+        inline InferenceDriverWarmUpArgs(std::string name, int version)
+            : srt::NamedObject(std::move(name)), version(version) {
+        }
+
+        int version;
+    };
+
     class InferenceSession;
 
     /// InferenceDriver - DiffSinger inference driver interface.
@@ -43,6 +61,17 @@ namespace ds {
         virtual srt::Expected<void> initialize(const srt::NO<InferenceDriverInitArgs> &args) = 0;
 
         virtual srt::NO<InferenceSession> createSession() = 0;
+
+        /// Prepares the open sessions for their first runs, so that the first real request sees
+        /// the steady-state latency. The default implementation does nothing.
+        virtual srt::Expected<void> warmUp(const srt::NO<InferenceDriverWarmUpArgs> &args) {
+            return srt::Expected<void>();
+        }
+
+        /// Returns the runtime statistics of the driver, or null if the driver reports none.
+        virtual srt::NO<InferenceDriverStatistics> statistics() const {
+            return {};
+        }
     };
 
 }
@@ -2,6 +2,8 @@
 #define DSINFER_INFERENCESESSION_H
 
 #include <filesystem>
+#include <string>
+#include <vector>
 
 #include <synthrt/Support/Expected.h>
 #include <synthrt/Task/ITask.h>
@@ -47,6 +49,15 @@ namespace ds {
         int version;
     };
 
+    class InferenceSessionBindingPlan : public srt::NamedObject {
+    public:
+        inline InferenceSessionBindingPlan(std::string name, int version)
+            : srt::NamedObject(std::move(name)), version(version) {
+        }
+
+        int version;
+    };
+
     /// InferenceSession - Provides a basic interface for the memory image of an AI model.
     class InferenceSession : public srt::ITask {
     public:
@@ -56,6 +67,15 @@ namespace ds {
         virtual bool isOpen() const = 0;
 
         virtual int64_t id() const = 0;
+
+        /// Resolves the given input and output port names once, so that later runs can pass
+        /// their tensors by slot instead of by name. The plan is only valid for this session
+        /// while it stays open. The default implementation reports that plans are unsupported.
+        virtual srt::Expected<srt::NO<InferenceSessionBindingPlan>>
+            createBindingPlan(const std::vector<std::string> &inputs,
+                              const std::vector<std::string> &outputs) {
+            return srt::Error(srt::Error::NotImplemented, "binding plans are not supported");
+        }
     };
 
 }
@@ -15,4 +15,9 @@
 #  endif
 #endif
 
+/// The alignment in bytes of the tensor buffers, set by the build.
+#ifndef DSINFER_TENSOR_ALIGNMENT
+#  define DSINFER_TENSOR_ALIGNMENT 64
+#endif
+
 #endif // DSINFER_DSINFER_GLOBAL_H
@@ -0,0 +1,61 @@
+#include "CancellationToken.h"
+
+#include <map>
+#include <mutex>
+
+#include <stdcorelib/pimpl.h>
+
+namespace ds {
+
+    class CancellationToken::Impl {
+    public:
+        // Also held while invoking the callbacks, so that unsubscribing waits for them
+        mutable std::mutex mutex;
+        bool cancelled = false;
+        int nextId = 1;
+        std::map<int, Callback> callbacks;
+    };
+
+    CancellationToken::CancellationToken() : _impl(std::make_unique<Impl>()) {
+    }
+
+    CancellationToken::~CancellationToken() = default;
+
+    void CancellationToken::cancel() {
+        __stdc_impl_t;
+        std::lock_guard<std::mutex> lock(impl.mutex);
+        if (impl.cancelled) {
+            return;
+        }
+        impl.cancelled = true;
+        for (const auto &[id, callback] : impl.callbacks) {
+            callback();
+        }
+        impl.callbacks.clear();
+    }
+
+    bool CancellationToken::isCancelled() const {
+        __stdc_impl_t;
+        std::lock_guard<std::mutex> lock(impl.mutex);
+        return impl.cancelled;
+    }
+
+    int CancellationToken::subscribe(Callback callback) {
+        __stdc_impl_t;
+        std::lock_guard<std::mutex> lock(impl.mutex);
+        if (impl.cancelled) {
+            callback();
+            return 0;
+        }
+        auto id = impl.nextId++;
+        impl.callbacks.emplace(id, std::move(callback));
+        return id;
+    }
+
+    void CancellationToken::unsubscribe(int id) {
+        __stdc_impl_t;
+        std::lock_guard<std::mutex> lock(impl.mutex);
+        impl.callbacks.erase(id);
+    }
+
+}
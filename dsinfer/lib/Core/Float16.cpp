@@ -0,0 +1,102 @@
+#include "Float16.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#  include <immintrin.h>
+#  define DSINFER_FLOAT16_F16C
+// Built without -mf16c by default, so the F16C functions are compiled for that target alone
+// and only called if the CPU supports it.
+#  define DSINFER_F16C_TARGET __attribute__((target("f16c,avx")))
+#elif defined(_MSC_VER) && defined(__AVX2__)
+#  include <immintrin.h>
+#  define DSINFER_FLOAT16_F16C
+#  define DSINFER_F16C_TARGET
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#  include <arm_neon.h>
+#  define DSINFER_FLOAT16_NEON
+#endif
+
+namespace ds {
+
+#if defined(DSINFER_FLOAT16_F16C)
+    static bool hasF16C() {
+#  if defined(__F16C__) || defined(_MSC_VER)
+        return true;
+#  else
+        static const bool supported =
+            __builtin_cpu_supports("f16c") && __builtin_cpu_supports("avx");
+        return supported;
+#  endif
+    }
+
+    // Converts the leading multiple of 8 elements, returns the number converted.
+    DSINFER_F16C_TARGET static size_t convertFloatToFloat16F16C(const float *src, Float16 *dst,
+                                                                size_t count) {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m256 v = _mm256_loadu_ps(src + i);
+            const __m128i h = _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), h);
+        }
+        return i;
+    }
+
+    DSINFER_F16C_TARGET static size_t convertFloat16ToFloatF16C(const Float16 *src, float *dst,
+                                                                size_t count) {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+            _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+        }
+        return i;
+    }
+#endif
+
+    void convertFloatToFloat16(const float *src, Float16 *dst, size_t count) {
+        size_t i = 0;
+#if defined(DSINFER_FLOAT16_F16C)
+        if (hasF16C()) {
+            i = convertFloatToFloat16F16C(src, dst, count);
+        }
+#elif defined(DSINFER_FLOAT16_NEON)
+        for (; i + 4 <= count; i += 4) {
+            const float16x4_t h = vcvt_f16_f32(vld1q_f32(src + i));
+            vst1_u16(reinterpret_cast<uint16_t *>(dst + i), vreinterpret_u16_f16(h));
+        }
+#endif
+        for (; i < count; ++i) {
+            dst[i].bits = Float16::fromFloat(src[i]);
+        }
+    }
+
+    void convertFloat16ToFloat(const Float16 *src, float *dst, size_t count) {
+        size_t i = 0;
+#if defined(DSINFER_FLOAT16_F16C)
+        if (hasF16C()) {
+            i = convertFloat16ToFloatF16C(src, dst, count);
+        }
+#elif defined(DSINFER_FLOAT16_NEON)
+        for (; i + 4 <= count; i += 4) {
+            const uint16x4_t h = vld1_u16(reinterpret_cast<const uint16_t *>(src + i));
+            vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(h)));
+        }
+#endif
+        for (; i < count; ++i) {
+            dst[i] = Float16::toFloat(src[i].bits);
+        }
+    }
+
+    // The bfloat16 conversions are plain integer operations that compilers vectorize well.
+
+    void convertFloatToBFloat16(const float *src, BFloat16 *dst, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            dst[i].bits = BFloat16::fromFloat(src[i]);
+        }
+    }
+
+    void convertBFloat16ToFloat(const BFloat16 *src, float *dst, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            dst[i] = BFloat16::toFloat(src[i].bits);
+        }
+    }
+
+}
@@ -1,6 +1,8 @@
 #include "Tensor.h"
 
+#include <atomic>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 
 namespace ds {
@@ -13,6 +15,10 @@ namespace ds {
                 return sizeof(int64_t);
             case ITensor::Bool:
                 return sizeof(bool);
+            case ITensor::Float16:
+                return sizeof(Float16);
+            case ITensor::BFloat16:
+                return sizeof(BFloat16);
             default:
                 assert(false && "Unsupported data type");
                 return 0;
@@ -82,8 +88,8 @@ namespace ds {
         return srt::Expected<void>();
     }
 
-    srt::Expected<srt::NO<Tensor>> Tensor::create(DataType dataType,
-                                                  const std::vector<int64_t> &shape) {
+    static srt::Expected<size_t> getByteSizeFromShape(ITensor::DataType dataType,
+                                                      const std::vector<int64_t> &shape) {
         auto maybeTotalElements = getElementCountFromShape(dataType, shape);
         if (!maybeTotalElements.has_value()) {
             return srt::Error(srt::Error::InvalidArgument, "invalid shape");
@@ -94,10 +100,34 @@ namespace ds {
         if (elementSize == 0) {
             return srt::Error(srt::Error::InvalidArgument, "invalid data type");
         }
+        return totalElements * elementSize;
+    }
+
+    srt::Expected<srt::NO<Tensor>> Tensor::create(DataType dataType,
+                                                  const std::vector<int64_t> &shape) {
+        auto exp = getByteSizeFromShape(dataType, shape);
+        if (!exp) {
+            return exp.takeError();
+        }
         auto tensor = srt::NO<Tensor>::create();
         tensor->_dataType = dataType;
         tensor->_shape = shape;
-        tensor->_data = Container(totalElements * elementSize, std::byte{0});
+        tensor->_data = std::make_shared<Container>(exp.value(), std::byte{0});
+        return tensor;
+    }
+
+    srt::Expected<srt::NO<Tensor>> Tensor::createUninitialized(DataType dataType,
+                                                               const std::vector<int64_t> &shape) {
+        auto exp = getByteSizeFromShape(dataType, shape);
+        if (!exp) {
+            return exp.takeError();
+        }
+        auto tensor = srt::NO<Tensor>::create();
+        tensor->_dataType = dataType;
+        tensor->_shape = shape;
+        // The bytes are left as allocated
+        tensor->_data =
+            std::make_shared<Container>(exp.value(), Container::allocator_type::uninitialized());
         return tensor;
     }
 
@@ -110,7 +140,7 @@ namespace ds {
         }
         tensor->_dataType = dataType;
         tensor->_shape = shape;
-        tensor->_data = data;
+        tensor->_data = std::make_shared<Container>(data);
         return tensor;
     }
 
@@ -123,7 +153,7 @@ namespace ds {
         }
         tensor->_dataType = dataType;
         tensor->_shape = shape;
-        tensor->_data = Container{data.begin(), data.end()};
+        tensor->_data = std::make_shared<Container>(data.begin(), data.end());
         return tensor;
     }
 
@@ -136,7 +166,7 @@ namespace ds {
         }
         tensor->_dataType = dataType;
         tensor->_shape = shape;
-        tensor->_data = std::move(data);
+        tensor->_data = std::make_shared<Container>(std::move(data));
         return tensor;
     }
 
@@ -153,7 +183,7 @@ namespace ds {
     }
 
     size_t Tensor::byteSize() const {
-        return _data.size();
+        return _data ? _data->size() : 0;
     }
 
     size_t Tensor::elementCount() const {
@@ -168,15 +198,36 @@ namespace ds {
     }
 
     const std::byte *Tensor::rawData() const {
-        return _data.data();
+        return _data ? _data->data() : nullptr;
     }
 
     std::byte *Tensor::mutableRawData() {
-        return _data.data();
+        if (!_data) {
+            return nullptr;
+        }
+        // Copy on write, the clones sharing the buffer keep the old one
+        if (_data.use_count() > 1) {
+            auto data = std::make_shared<Container>(_data->size(),
+                                                    Container::allocator_type::uninitialized());
+            std::memcpy(data->data(), _data->data(), _data->size());
+            _data = std::move(data);
+        } else {
+            // use_count() is a relaxed load, order the writes after the reads of the clones
+            // that released the buffer on other threads
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return _data->data();
     }
 
     stdc::array_view<std::byte> Tensor::rawView() const {
-        return {_data.data(), _data.size()};
+        if (!_data) {
+            return {};
+        }
+        return {_data->data(), _data->size()};
+    }
+
+    size_t Tensor::alignment() const {
+        return std::max(ITensor::alignment(), ALIGNMENT);
     }
 
     srt::NO<ITensor> Tensor::clone() const {
@@ -187,4 +238,8 @@ namespace ds {
         return tensor;
     }
 
+    bool Tensor::isShared() const {
+        return _data && _data.use_count() > 1;
+    }
+
 }
\ No newline at end of file
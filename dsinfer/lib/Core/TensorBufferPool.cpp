@@ -0,0 +1,194 @@
+#include "TensorBufferPool.h"
+
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace ds {
+
+    namespace {
+
+        constexpr int MIN_SHIFT = 6;
+        constexpr int MAX_SHIFT = 26;
+        constexpr int STEPS = 4;
+
+        // Size classes: MIN_BLOCK_SIZE, then four evenly spaced sizes up to each next power of
+        // two, ending at MAX_BLOCK_SIZE
+        constexpr int CLASS_COUNT = (MAX_SHIFT - MIN_SHIFT) * STEPS + 1;
+
+        static_assert(TensorBufferPool::MIN_BLOCK_SIZE == size_t(1) << MIN_SHIFT);
+        static_assert(TensorBufferPool::MAX_BLOCK_SIZE == size_t(1) << MAX_SHIFT);
+        static_assert(TensorBufferPool::MIN_BLOCK_SIZE >= sizeof(void *));
+
+        using SystemAllocator = AlignedAllocator<std::byte, TensorBufferPool::ALIGNMENT>;
+
+        inline int floorLog2(size_t value) {
+            int result = 0;
+            while (value >>= 1) {
+                ++result;
+            }
+            return result;
+        }
+
+        // Returns the class of a size not over MAX_BLOCK_SIZE, and the block size of the class.
+        inline int sizeClassIndex(size_t size, size_t *blockSize) {
+            if (size <= TensorBufferPool::MIN_BLOCK_SIZE) {
+                *blockSize = TensorBufferPool::MIN_BLOCK_SIZE;
+                return 0;
+            }
+            // base < size <= 2 * base
+            int shift = floorLog2(size - 1);
+            size_t base = size_t(1) << shift;
+            size_t step = base / STEPS;
+            size_t index = (size - base + step - 1) / step;
+            *blockSize = base + index * step;
+            return (shift - MIN_SHIFT) * STEPS + static_cast<int>(index);
+        }
+
+        inline size_t classBlockSize(int index) {
+            if (index == 0) {
+                return TensorBufferPool::MIN_BLOCK_SIZE;
+            }
+            size_t base = size_t(1) << ((index - 1) / STEPS + MIN_SHIFT);
+            return base + ((index - 1) % STEPS + 1) * (base / STEPS);
+        }
+
+        // The free blocks of a class form a list linked through their first bytes
+        struct FreeBlock {
+            FreeBlock *next;
+        };
+
+        struct SizeClass {
+            std::mutex mutex;
+            FreeBlock *head = nullptr;
+            size_t cachedBlocks = 0;
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+        };
+
+        struct Pool {
+            std::array<SizeClass, CLASS_COUNT> classes;
+            std::atomic<size_t> cachedBytes = 0;
+            std::atomic<size_t> capacity = size_t(256) << 20;
+            std::atomic<uint64_t> largeAllocations = 0;
+
+            static Pool &global() {
+                // Never destroyed, the tensors of static objects may be freed after exit
+                static auto instance = new Pool();
+                return *instance;
+            }
+
+            // Frees the held blocks until at most the given bytes are held, from the largest
+            // classes down.
+            size_t shrink(size_t limit) {
+                size_t freed = 0;
+                for (int i = CLASS_COUNT - 1; i >= 0 && cachedBytes > limit; --i) {
+                    auto &sizeClass = classes[i];
+                    auto blockSize = classBlockSize(i);
+
+                    std::lock_guard<std::mutex> lock(sizeClass.mutex);
+                    while (sizeClass.head && cachedBytes > limit) {
+                        auto block = sizeClass.head;
+                        sizeClass.head = block->next;
+                        sizeClass.cachedBlocks--;
+                        cachedBytes -= blockSize;
+                        freed += blockSize;
+                        SystemAllocator().deallocate(reinterpret_cast<std::byte *>(block),
+                                                     blockSize);
+                    }
+                }
+                return freed;
+            }
+        };
+
+    }
+
+    void *TensorBufferPool::allocate(size_t size) {
+        auto &pool = Pool::global();
+        if (size > MAX_BLOCK_SIZE) {
+            pool.largeAllocations++;
+            return SystemAllocator().allocate(size);
+        }
+
+        size_t blockSize;
+        auto &sizeClass = pool.classes[sizeClassIndex(size, &blockSize)];
+        {
+            std::lock_guard<std::mutex> lock(sizeClass.mutex);
+            if (auto block = sizeClass.head) {
+                sizeClass.head = block->next;
+                sizeClass.cachedBlocks--;
+                sizeClass.hits++;
+                pool.cachedBytes -= blockSize;
+                return block;
+            }
+            sizeClass.misses++;
+        }
+        return SystemAllocator().allocate(blockSize);
+    }
+
+    void TensorBufferPool::deallocate(void *ptr, size_t size) noexcept {
+        if (!ptr) {
+            return;
+        }
+        auto &pool = Pool::global();
+        if (size > MAX_BLOCK_SIZE) {
+            SystemAllocator().deallocate(static_cast<std::byte *>(ptr), size);
+            return;
+        }
+
+        size_t blockSize;
+        auto &sizeClass = pool.classes[sizeClassIndex(size, &blockSize)];
+        if (pool.cachedBytes.fetch_add(blockSize) + blockSize > pool.capacity) {
+            pool.cachedBytes -= blockSize;
+            SystemAllocator().deallocate(static_cast<std::byte *>(ptr), blockSize);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        auto block = static_cast<FreeBlock *>(ptr);
+        block->next = sizeClass.head;
+        sizeClass.head = block;
+        sizeClass.cachedBlocks++;
+    }
+
+    void TensorBufferPool::setCapacity(size_t bytes) {
+        auto &pool = Pool::global();
+        pool.capacity = bytes;
+        pool.shrink(bytes);
+    }
+
+    size_t TensorBufferPool::capacity() {
+        return Pool::global().capacity;
+    }
+
+    size_t TensorBufferPool::trim() {
+        return Pool::global().shrink(0);
+    }
+
+    TensorBufferPool::Statistics TensorBufferPool::statistics() {
+        auto &pool = Pool::global();
+        Statistics stats;
+        stats.capacity = pool.capacity;
+        stats.misses = pool.largeAllocations;
+        for (int i = 0; i < CLASS_COUNT; ++i) {
+            auto &sizeClass = pool.classes[i];
+            SizeClassStatistics classStats;
+            {
+                std::lock_guard<std::mutex> lock(sizeClass.mutex);
+                classStats.cachedBlocks = sizeClass.cachedBlocks;
+                classStats.hits = sizeClass.hits;
+                classStats.misses = sizeClass.misses;
+            }
+            if (classStats.hits == 0 && classStats.misses == 0 && classStats.cachedBlocks == 0) {
+                continue;
+            }
+            classStats.blockSize = classBlockSize(i);
+            stats.hits += classStats.hits;
+            stats.misses += classStats.misses;
+            stats.sizeClasses.push_back(classStats);
+        }
+        stats.cachedBytes = pool.cachedBytes;
+        return stats;
+    }
+
+}
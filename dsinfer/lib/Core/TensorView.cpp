@@ -0,0 +1,194 @@
+#include "TensorView.h"
+
+#include <cstring>
+
+namespace ds {
+
+    srt::Expected<srt::NO<TensorView>> TensorView::create(const srt::NO<ITensor> &tensor) {
+        if (!tensor) {
+            return srt::Error(srt::Error::InvalidArgument, "tensor is null");
+        }
+        auto view = srt::NO<TensorView>::create();
+        if (tensor->backend() == BACKEND) {
+            auto other = tensor.as<TensorView>();
+            view->_base = other->_base;
+            view->_offset = other->_offset;
+            view->_shape = other->_shape;
+            view->_strides = other->_strides;
+            return view;
+        }
+        if (tensor->dataType() == Undefined) {
+            return srt::Error(srt::Error::InvalidArgument, "data type can not be Undefined");
+        }
+        view->_base = tensor;
+        view->_shape = tensor->shape();
+        view->_strides = tensor->strides();
+        if (view->_strides.size() != view->_shape.size()) {
+            return srt::Error(srt::Error::InvalidArgument, "strides and shape mismatch");
+        }
+        return view;
+    }
+
+    srt::Expected<srt::NO<TensorView>> TensorView::slice(size_t axis, int64_t begin,
+                                                         int64_t end) const {
+        if (axis >= _shape.size()) {
+            return srt::Error(srt::Error::InvalidArgument, "axis out of range");
+        }
+        const auto dim = _shape[axis];
+        if (begin < 0) {
+            begin += dim;
+        }
+        if (end < 0) {
+            end += dim;
+        }
+        if (begin < 0 || end > dim || begin >= end) {
+            return srt::Error(srt::Error::InvalidArgument, "invalid slice range");
+        }
+        auto view = srt::NO<TensorView>::create();
+        view->_base = _base;
+        view->_offset = _offset + begin * _strides[axis];
+        view->_shape = _shape;
+        view->_shape[axis] = end - begin;
+        view->_strides = _strides;
+        return view;
+    }
+
+    srt::NO<ITensor> TensorView::base() const {
+        return _base;
+    }
+
+    int64_t TensorView::offset() const {
+        return _offset;
+    }
+
+    std::string TensorView::backend() const {
+        return BACKEND;
+    }
+
+    ITensor::DataType TensorView::dataType() const {
+        return _base ? _base->dataType() : Undefined;
+    }
+
+    std::vector<int64_t> TensorView::shape() const {
+        return _shape;
+    }
+
+    size_t TensorView::byteSize() const {
+        return elementCount() * elementSize();
+    }
+
+    size_t TensorView::elementCount() const {
+        if (!_base) {
+            return 0;
+        }
+        size_t count = 1;
+        for (const auto dim : _shape) {
+            count *= static_cast<size_t>(dim);
+        }
+        return count;
+    }
+
+    size_t TensorView::elementSize() const {
+        return _base ? _base->elementSize() : 0;
+    }
+
+    std::vector<int64_t> TensorView::strides() const {
+        return _strides;
+    }
+
+    bool TensorView::isContiguous() const {
+        int64_t expected = 1;
+        for (size_t i = _shape.size(); i > 0; --i) {
+            // The stride of an axis of length 1 is never used
+            if (_shape[i - 1] != 1 && _strides[i - 1] != expected) {
+                return false;
+            }
+            expected *= _shape[i - 1];
+        }
+        return true;
+    }
+
+    const std::byte *TensorView::rawData() const {
+        if (!_base) {
+            return nullptr;
+        }
+        return _base->rawData() + _offset * static_cast<int64_t>(elementSize());
+    }
+
+    std::byte *TensorView::mutableRawData() {
+        if (!_base) {
+            return nullptr;
+        }
+        return _base->mutableRawData() + _offset * static_cast<int64_t>(elementSize());
+    }
+
+    stdc::array_view<std::byte> TensorView::rawView() const {
+        if (!_base || !isContiguous()) {
+            return {};
+        }
+        return {rawData(), byteSize()};
+    }
+
+    srt::NO<ITensor> TensorView::clone() const {
+        if (!_base) {
+            return {};
+        }
+        if (isContiguous()) {
+            // A view of a whole tensor shares its buffer until either is written
+            if (_base->backend() == Tensor::BACKEND && _offset == 0 &&
+                elementCount() == _base->elementCount()) {
+                return _base->clone();
+            }
+            auto exp = Tensor::createFromRawView(dataType(), _shape, rawView());
+            if (!exp) {
+                return {};
+            }
+            return exp.take();
+        }
+
+        auto exp = Tensor::createUninitialized(dataType(), _shape);
+        if (!exp) {
+            return {};
+        }
+        auto tensor = exp.take();
+
+        // Gather the rows of the innermost axis, which are copied at once when contiguous
+        const auto rank = _shape.size();
+        const auto size = static_cast<int64_t>(elementSize());
+        const auto rowLength = _shape[rank - 1];
+        const auto rowStride = _strides[rank - 1];
+        const auto src = rawData();
+        auto dst = tensor->mutableRawData();
+
+        std::vector<int64_t> index(rank, 0);
+        for (;;) {
+            int64_t offset = 0;
+            for (size_t i = 0; i + 1 < rank; ++i) {
+                offset += index[i] * _strides[i];
+            }
+            if (rowStride == 1) {
+                std::memcpy(dst, src + offset * size, rowLength * size);
+                dst += rowLength * size;
+            } else {
+                for (int64_t j = 0; j < rowLength; ++j) {
+                    std::memcpy(dst, src + (offset + j * rowStride) * size, size);
+                    dst += size;
+                }
+            }
+
+            // Next outer index
+            size_t i = rank - 1;
+            for (; i > 0; --i) {
+                if (++index[i - 1] < _shape[i - 1]) {
+                    break;
+                }
+                index[i - 1] = 0;
+            }
+            if (i == 0) {
+                break;
+            }
+        }
+        return tensor;
+    }
+
+}
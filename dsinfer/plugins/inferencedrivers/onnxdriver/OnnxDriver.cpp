@@ -10,6 +10,10 @@
 #include "OnnxSession.h"
 #include "OnnxDriver_Logger.h"
 #include "internal/Env.h"
+#include "internal/ModelCache.h"
+#include "internal/ImageResidency.h"
+#include "internal/ArenaTrimming.h"
+#include "internal/Session.h"
 
 #ifndef ORT_API_MANUAL_INIT
 #  error "dsinfer requires ort to be manually initialized, but ORT_API_MANUAL_INIT is not set!"
@@ -45,6 +49,14 @@ namespace ds {
         }
 
         ~Impl() {
+            // The environment must go away before the library that owns it. The sessions
+            // still open lose their loaded models first, unless they are running.
+            onnxdriver::ImageResidency::unloadIdle(std::chrono::steady_clock::time_point::max());
+            if (!onnxdriver::Env::releaseOrtEnv()) {
+                // Their ORT objects would outlive the library, so it is left loaded
+                Log.srtWarning("Exit - Sessions are still running, keeping the ORT library loaded");
+                (void) ortDSO.release();
+            }
         }
 
         srt::Expected<void> load(const fs::path &path) {
@@ -173,10 +185,39 @@ namespace ds {
             };
         }
 
+        onnxdriver::Env::ThreadingConfig threadingConfig;
+        threadingConfig.useGlobalThreadPools = onnxArgs->useGlobalThreadPools;
+        threadingConfig.intraOpNumThreads = onnxArgs->intraOpNumThreads;
+        threadingConfig.interOpNumThreads = onnxArgs->interOpNumThreads;
+        threadingConfig.allowSpinning = onnxArgs->allowSpinning;
+        threadingConfig.intraOpCores = onnxArgs->intraOpCores;
+        onnxdriver::Env::MemoryConfig memoryConfig;
+        memoryConfig.shareCpuAllocator = onnxArgs->shareCpuAllocator;
+        memoryConfig.sharePrepackedWeights = onnxArgs->sharePrepackedWeights;
+        if (std::string errorMessage;
+            !onnxdriver::Env::createOrtEnv(threadingConfig, memoryConfig, &errorMessage)) {
+            Log.srtCritical("Init - Failed to create onnx environment: %1", errorMessage);
+            return srt::Error{
+                srt::Error::SessionError,
+                "failed to create onnx environment: " + errorMessage,
+            };
+        }
+
         onnxdriver::Env::DeviceConfig devConfig;
         devConfig.ep = onnxArgs->ep;
         devConfig.deviceIndex = onnxArgs->deviceIndex;
         onnxdriver::Env::setDeviceConfig(devConfig);
+
+        onnxdriver::Env::ProfilingConfig profilingConfig;
+        profilingConfig.directory = onnxArgs->profilingDirectory;
+        profilingConfig.sink = onnxArgs->profilingSink;
+        onnxdriver::Env::setProfilingConfig(profilingConfig);
+
+        onnxdriver::ModelCache::initialize(onnxArgs->cacheDirectory,
+                                           impl.ortApiBase->GetVersionString());
+        onnxdriver::ImageResidency::setBudget(onnxArgs->residentMemoryBudget);
+        onnxdriver::ArenaTrimming::global().setPolicy(onnxArgs->arenaShrinkThreshold,
+                                                      onnxArgs->arenaIdleTimeout);
         return srt::Expected<void>();
     }
 
@@ -185,4 +226,34 @@ namespace ds {
         return session;
     }
 
+    srt::Expected<void> OnnxDriver::warmUp(const srt::NO<InferenceDriverWarmUpArgs> &args) {
+        if (!args || args->objectName() != Onnx::API_NAME) {
+            return srt::Error{srt::Error::InvalidArgument, "invalid driver warm-up args"};
+        }
+        auto onnxArgs = args.as<Onnx::DriverWarmUpArgs>();
+        if (onnxArgs->length <= 0) {
+            return srt::Error{srt::Error::InvalidArgument, "warm-up length must be positive"};
+        }
+
+        auto count = onnxdriver::Session::warmUpImages(onnxArgs->length, onnxArgs->models);
+        Log.srtInfo("Warm-up - %1 session image(s) ready", count);
+        return srt::Expected<void>();
+    }
+
+    srt::NO<InferenceDriverStatistics> OnnxDriver::statistics() const {
+        auto residency = onnxdriver::ImageResidency::statistics();
+        auto stats = srt::NO<Api::Onnx::DriverStatistics>::create();
+        stats->residentModels = residency.residentImages;
+        stats->residentMemory = residency.residentBytes;
+        stats->residentMemoryBudget = residency.budget;
+        stats->evictions = residency.evictions;
+        stats->reloads = residency.reloads;
+
+        auto trimming = onnxdriver::ArenaTrimming::global().statistics();
+        stats->arenaShrinks = trimming.arenaShrinks;
+        stats->idleShrinks = trimming.idleShrinks;
+        stats->reclaimedMemory = trimming.reclaimedBytes;
+        return stats;
+    }
+
 }
@@ -19,6 +19,10 @@ namespace ds {
         srt::Expected<void> initialize(const srt::NO<InferenceDriverInitArgs> &args) override;
         srt::NO<InferenceSession> createSession() override;
 
+        srt::Expected<void> warmUp(const srt::NO<InferenceDriverWarmUpArgs> &args) override;
+
+        srt::NO<InferenceDriverStatistics> statistics() const override;
+
     protected:
         class Impl;
         std::unique_ptr<Impl> _impl;
@@ -53,6 +53,17 @@ namespace ds {
         return impl.sessionId;
     }
 
+    srt::Expected<srt::NO<InferenceSessionBindingPlan>>
+        OnnxSession::createBindingPlan(const std::vector<std::string> &inputs,
+                                       const std::vector<std::string> &outputs) {
+        __stdc_impl_t;
+        auto exp = impl.session.createBindingPlan(inputs, outputs);
+        if (!exp) {
+            return exp.takeError();
+        }
+        return exp.take().as<InferenceSessionBindingPlan>();
+    }
+
     srt::Expected<srt::NO<srt::TaskResult>> OnnxSession::start(const srt::NO<srt::TaskStartInput> &input) {
         __stdc_impl_t;
         return impl.session.run(input);
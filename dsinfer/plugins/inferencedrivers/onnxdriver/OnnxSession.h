@@ -18,6 +18,10 @@ namespace ds {
 
         int64_t id() const override;
 
+        srt::Expected<srt::NO<InferenceSessionBindingPlan>>
+            createBindingPlan(const std::vector<std::string> &inputs,
+                              const std::vector<std::string> &outputs) override;
+
     public:
         srt::Expected<srt::NO<srt::TaskResult>> start(const srt::NO<srt::TaskStartInput> &input) override;
         srt::Expected<void> startAsync(const srt::NO<srt::TaskStartInput> &input,
@@ -0,0 +1,98 @@
+#include "ArenaTrimming.h"
+
+#include "OnnxDriver_Logger.h"
+#include "ProcessMemory.h"
+#include "Session.h"
+
+namespace ds::onnxdriver {
+
+    ArenaTrimming::~ArenaTrimming() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _quit = true;
+        }
+        _cv.notify_all();
+        if (_thread.joinable()) {
+            _thread.join();
+        }
+    }
+
+    ArenaTrimming &ArenaTrimming::global() {
+        static ArenaTrimming instance;
+        return instance;
+    }
+
+    void ArenaTrimming::setPolicy(uintmax_t shrinkThreshold, Clock::duration idleTimeout) {
+        _shrinkThreshold = shrinkThreshold;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _idleTimeout = idleTimeout;
+            bool enabled = shrinkThreshold > 0 || _idleTimeout > Clock::duration::zero();
+            if (enabled && !_thread.joinable()) {
+                _thread = std::thread(&ArenaTrimming::watch, this);
+            }
+        }
+        _cv.notify_all();
+    }
+
+    void ArenaTrimming::endRun() {
+        uintmax_t threshold = _shrinkThreshold;
+        if (threshold == 0 || processResidentMemory() <= threshold) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _overThreshold = true;
+        }
+        _cv.notify_all();
+    }
+
+    ArenaTrimming::Statistics ArenaTrimming::statistics() {
+        Statistics stats;
+        stats.arenaShrinks = _arenaShrinks;
+        stats.idleShrinks = _idleShrinks;
+        stats.reclaimedBytes = _reclaimedBytes;
+        return stats;
+    }
+
+    void ArenaTrimming::watch() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (!_quit) {
+            auto woken = [this] { return _quit || _overThreshold; };
+            auto timeout = _idleTimeout;
+            if (timeout <= Clock::duration::zero()) {
+                _cv.wait(lock, woken);
+            } else {
+                // Checking twice per timeout shrinks an image within 1.5 timeouts of its last
+                // run
+                _cv.wait_for(lock, timeout / 2, woken);
+            }
+            if (_quit) {
+                break;
+            }
+            bool overThreshold = _overThreshold;
+            _overThreshold = false;
+            if (!overThreshold && timeout <= Clock::duration::zero()) {
+                continue;
+            }
+            lock.unlock();
+
+            // Over the threshold, the images that have just run are shrunk as well
+            auto idleBefore = overThreshold ? Clock::time_point::max() : Clock::now() - timeout;
+            auto residentBefore = processResidentMemory();
+            auto count = Session::shrinkArenas(idleBefore);
+            if (count > 0) {
+                auto resident = processResidentMemory();
+                (overThreshold ? _arenaShrinks : _idleShrinks) += count;
+                if (resident < residentBefore) {
+                    _reclaimedBytes += residentBefore - resident;
+                }
+                Log.srtInfo("ArenaTrimming - Shrunk the arenas of %1 image(s), %2 bytes freed",
+                            count, resident < residentBefore ? residentBefore - resident : 0);
+            }
+
+            lock.lock();
+        }
+    }
+
+}
@@ -0,0 +1,62 @@
+#ifndef DSINFER_ONNXDRIVER_ARENATRIMMING_H
+#define DSINFER_ONNXDRIVER_ARENATRIMMING_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace ds::onnxdriver {
+
+    // Gives the memory held by the ORT CPU arenas back to the system.
+    //
+    // ORT only shrinks an arena at the end of a run that asks for it, so a watch thread runs
+    // the loaded images for that, see Session::shrinkArenas(). The images that have not run for
+    // the idle timeout are shrunk, and all images are when a run leaves the process over the
+    // threshold. The shared CPU arena is shrunk by the run of any of them.
+    class ArenaTrimming {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        struct Statistics {
+            uint64_t arenaShrinks = 0;
+            uint64_t idleShrinks = 0;
+            uintmax_t reclaimedBytes = 0;
+        };
+
+        ~ArenaTrimming();
+
+        static ArenaTrimming &global();
+
+        // The threshold of the process resident memory in bytes, and the idle timeout. Zero
+        // disables either.
+        void setPolicy(uintmax_t shrinkThreshold, Clock::duration idleTimeout);
+
+        // Called after a run, wakes the watch thread if the process is over the threshold.
+        void endRun();
+
+        Statistics statistics();
+
+    protected:
+        ArenaTrimming() = default;
+
+        void watch();
+
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        std::atomic<uintmax_t> _shrinkThreshold = 0;
+        Clock::duration _idleTimeout = Clock::duration::zero();
+        bool _overThreshold = false;
+        bool _quit = false;
+        std::thread _thread;
+
+        std::atomic<uint64_t> _arenaShrinks = 0;
+        std::atomic<uint64_t> _idleShrinks = 0;
+        std::atomic<uintmax_t> _reclaimedBytes = 0;
+    };
+
+}
+
+#endif // DSINFER_ONNXDRIVER_ARENATRIMMING_H
@@ -3,8 +3,31 @@
 #include <stdexcept>
 #include <mutex>
 
+#include "OnnxDriver_Logger.h"
+
 namespace ds::onnxdriver {
 
+    static void loggingFuncOrt(void *param, OrtLoggingLevel severity, const char *category,
+                               const char *logid, const char *code_location, const char *message) {
+        switch (severity) {
+            case ORT_LOGGING_LEVEL_VERBOSE:
+                Log.srtLog(Debug, "[%1] %2", code_location, message);
+                break;
+            case ORT_LOGGING_LEVEL_WARNING:
+                Log.srtLog(Warning, "[%1] %2", code_location, message);
+                break;
+            case ORT_LOGGING_LEVEL_ERROR:
+                Log.srtLog(Critical, "[%1] %2", code_location, message);
+                break;
+            case ORT_LOGGING_LEVEL_FATAL:
+                Log.srtLog(Fatal, "[%1] %2", code_location, message);
+                break;
+            default:
+                Log.srtLog(Information, "[%1] %2", code_location, message);
+                break;
+        }
+    }
+
     void Env::setDeviceConfig(const DeviceConfig& config) {
         std::unique_lock lock(s_mutex);
         s_deviceConfig = config;
@@ -15,7 +38,145 @@ namespace ds::onnxdriver {
         return s_deviceConfig;
     }
 
+    void Env::setProfilingConfig(const ProfilingConfig &config) {
+        std::unique_lock lock(s_mutex);
+        s_profilingConfig = config;
+    }
+
+    Env::ProfilingConfig Env::getProfilingConfig() {
+        std::shared_lock lock(s_mutex);
+        return s_profilingConfig;
+    }
+
     int64_t Env::nextId() {
         return ++s_idCounter;
     }
-} // namespace ds::onnxdriver
\ No newline at end of file
+
+    std::string Env::intraOpThreadAffinities(const std::vector<int> &cores, int numThreads) {
+        std::string result;
+        if (cores.empty()) {
+            return result;
+        }
+        // The processor ids of ORT start from 1. The threads start from the second core, the
+        // first one is left to the calling thread, which the session pins for the run.
+        for (int i = 1; i < numThreads; ++i) {
+            if (!result.empty()) {
+                result += ';';
+            }
+            result += std::to_string(cores[i % cores.size()] + 1);
+        }
+        return result;
+    }
+
+    bool Env::createOrtEnv(const ThreadingConfig &config, const MemoryConfig &memoryConfig,
+                           std::string *errorMessage) {
+        std::unique_lock lock(s_mutex);
+        if (s_ortEnv) {
+            return true;
+        }
+        int globalIntraOpNumThreads = 0;
+        int globalIntraOpCallerCore = -1;
+        try {
+            if (config.useGlobalThreadPools) {
+                // Sessions created with DisablePerSessionThreads() share these pools, so the
+                // stages of a singer no longer oversubscribe the cores when running together.
+                Ort::ThreadingOptions threadingOptions;
+                threadingOptions.SetGlobalIntraOpNumThreads(config.intraOpNumThreads);
+                threadingOptions.SetGlobalInterOpNumThreads(config.interOpNumThreads);
+                threadingOptions.SetGlobalSpinControl(config.allowSpinning ? 1 : 0);
+                globalIntraOpNumThreads = config.intraOpNumThreads;
+                if (!config.intraOpCores.empty()) {
+                    int numThreads = config.intraOpNumThreads > 0
+                                         ? config.intraOpNumThreads
+                                         : static_cast<int>(config.intraOpCores.size());
+                    threadingOptions.SetGlobalIntraOpNumThreads(numThreads);
+                    globalIntraOpNumThreads = numThreads;
+                    globalIntraOpCallerCore = config.intraOpCores.front();
+                    auto affinities = intraOpThreadAffinities(config.intraOpCores, numThreads);
+                    if (!affinities.empty()) {
+                        Ort::ThrowOnError(Ort::GetApi().SetGlobalIntraOpThreadAffinity(
+                            threadingOptions, affinities.c_str()));
+                    }
+                }
+                s_ortEnv = std::make_shared<Ort::Env>(threadingOptions, loggingFuncOrt, nullptr,
+                                                      ORT_LOGGING_LEVEL_WARNING, "dsinfer");
+                Log.srtInfo("Env - Created with global thread pools (intra-op: %1, inter-op: %2)",
+                            config.intraOpNumThreads, config.interOpNumThreads);
+            } else {
+                s_ortEnv = std::make_shared<Ort::Env>(ORT_LOGGING_LEVEL_WARNING, "dsinfer",
+                                                      loggingFuncOrt, nullptr);
+                Log.srtInfo("Env - Created with per-session thread pools");
+            }
+
+            if (memoryConfig.shareCpuAllocator) {
+                // Sessions created with "session.use_env_allocators" allocate from this arena
+                // instead of keeping one each, and the memory freed by one session can be
+                // reused by the others.
+                auto memInfo = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+                Ort::ArenaCfg arenaCfg(0, -1, -1, -1); // default settings
+                s_ortEnv->CreateAndRegisterAllocator(memInfo, arenaCfg);
+                Log.srtInfo("Env - Registered shared CPU arena allocator");
+            }
+            if (memoryConfig.sharePrepackedWeights) {
+                // The weights prepacked for the kernels are keyed by content, so the sessions
+                // of the same model share them even when opened with different options.
+                s_prepackedWeights = std::make_shared<Ort::PrepackedWeightsContainer>();
+            }
+        } catch (const Ort::Exception &e) {
+            s_prepackedWeights.reset();
+            s_ortEnv.reset();
+            if (errorMessage) {
+                *errorMessage = e.what();
+            }
+            return false;
+        }
+        s_globalThreadPools = config.useGlobalThreadPools;
+        s_globalIntraOpNumThreads = globalIntraOpNumThreads;
+        s_globalIntraOpCallerCore = globalIntraOpCallerCore;
+        s_sharedCpuAllocator = memoryConfig.shareCpuAllocator;
+        return true;
+    }
+
+    bool Env::releaseOrtEnv() {
+        std::unique_lock lock(s_mutex);
+        // The loaded sessions hold their own references, the last of them destroys these
+        std::weak_ptr<Ort::Env> env = s_ortEnv;
+        s_prepackedWeights.reset();
+        s_ortEnv.reset();
+        s_globalThreadPools = false;
+        s_globalIntraOpNumThreads = 0;
+        s_globalIntraOpCallerCore = -1;
+        s_sharedCpuAllocator = false;
+        return env.expired();
+    }
+
+    std::shared_ptr<Ort::Env> Env::ortEnv() {
+        std::shared_lock lock(s_mutex);
+        return s_ortEnv;
+    }
+
+    bool Env::useGlobalThreadPools() {
+        std::shared_lock lock(s_mutex);
+        return s_globalThreadPools;
+    }
+
+    int Env::globalIntraOpNumThreads() {
+        std::shared_lock lock(s_mutex);
+        return s_globalIntraOpNumThreads;
+    }
+
+    int Env::globalIntraOpCallerCore() {
+        std::shared_lock lock(s_mutex);
+        return s_globalIntraOpCallerCore;
+    }
+
+    bool Env::useSharedCpuAllocator() {
+        std::shared_lock lock(s_mutex);
+        return s_sharedCpuAllocator;
+    }
+
+    std::shared_ptr<Ort::PrepackedWeightsContainer> Env::prepackedWeightsContainer() {
+        std::shared_lock lock(s_mutex);
+        return s_prepackedWeights;
+    }
+} // namespace ds::onnxdriver
@@ -2,9 +2,15 @@
 #define DSINFER_ONNXDRIVER_ENV_H
 
 #include <atomic>
+#include <filesystem>
+#include <memory>
 #include <shared_mutex>
+#include <string>
+#include <vector>
 #include <dsinfer/Api/Drivers/Onnx/OnnxDriverApi.h>
 
+#include <onnxruntime_cxx_api.h>
+
 namespace ds::onnxdriver {
 
     class Env {
@@ -20,13 +26,79 @@ namespace ds::onnxdriver {
             int deviceIndex;
         };
 
+        struct ThreadingConfig {
+            bool useGlobalThreadPools = true;
+            int intraOpNumThreads = 0;
+            int interOpNumThreads = 0;
+            bool allowSpinning = true;
+            std::vector<int> intraOpCores;
+        };
+
+        struct MemoryConfig {
+            bool shareCpuAllocator = true;
+            bool sharePrepackedWeights = true;
+        };
+
+        struct ProfilingConfig {
+            std::filesystem::path directory;
+            Api::Onnx::ProfilingSink sink;
+        };
+
         // Set/Get the entire device config atomically
         static void setDeviceConfig(const DeviceConfig& config);
         static DeviceConfig getDeviceConfig();
         static int64_t nextId();
 
+        static void setProfilingConfig(const ProfilingConfig &config);
+        static ProfilingConfig getProfilingConfig();
+
+        // Returns the ORT thread affinity string that pins the threads of an intra-op pool of
+        // the given size to the cores in turn. The calling thread counts as the first thread of
+        // the pool, but ORT does not pin it, so there is one entry less than the threads and
+        // the first core is left to the caller, which the session pins for the run.
+        static std::string intraOpThreadAffinities(const std::vector<int> &cores,
+                                                   int numThreads);
+
+        // Create the driver-wide ORT environment shared by all session images. Must be called
+        // once after the ORT api is initialized.
+        static bool createOrtEnv(const ThreadingConfig &config, const MemoryConfig &memoryConfig,
+                                 std::string *errorMessage = nullptr);
+
+        // Release the ORT environment. Must be called before the ORT library is unloaded.
+        // The session images that are still loaded keep their references to the environment
+        // and the prepacked weights, which are then destroyed with the last of them. Returns
+        // false in that case.
+        static bool releaseOrtEnv();
+
+        // Returns null if the environment has not been created. The sessions must hold the
+        // reference as long as they are alive.
+        static std::shared_ptr<Ort::Env> ortEnv();
+
+        // Whether sessions should run on the environment's global thread pools.
+        static bool useGlobalThreadPools();
+
+        // The number of threads of the global intra-op pool, 0 if ORT chose it.
+        static int globalIntraOpNumThreads();
+
+        // The core to pin the threads calling the sessions on the global pools to, see
+        // intraOpThreadAffinities(). Negative if the global pools are not pinned.
+        static int globalIntraOpCallerCore();
+
+        // Whether sessions should allocate from the CPU arena registered in the environment.
+        static bool useSharedCpuAllocator();
+
+        // Returns null if the prepacked weights are not shared.
+        static std::shared_ptr<Ort::PrepackedWeightsContainer> prepackedWeightsContainer();
+
     private:
         static inline DeviceConfig s_deviceConfig;
+        static inline ProfilingConfig s_profilingConfig;
+        static inline std::shared_ptr<Ort::Env> s_ortEnv;
+        static inline bool s_globalThreadPools = false;
+        static inline int s_globalIntraOpNumThreads = 0;
+        static inline int s_globalIntraOpCallerCore = -1;
+        static inline bool s_sharedCpuAllocator = false;
+        static inline std::shared_ptr<Ort::PrepackedWeightsContainer> s_prepackedWeights;
         static inline std::shared_mutex s_mutex;
         static inline std::atomic<int64_t> s_idCounter = 0;
     };
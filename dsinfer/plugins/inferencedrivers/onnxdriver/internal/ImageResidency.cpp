@@ -0,0 +1,107 @@
+#include "ImageResidency.h"
+
+#include "OnnxDriver_Logger.h"
+#include "SessionImage.h"
+
+namespace ds::onnxdriver {
+
+    void ImageResidency::setBudget(uintmax_t budget) {
+        std::vector<ProfilingTrace> traces;
+        {
+            std::lock_guard<std::mutex> lock(s_mutex);
+            s_budget = budget;
+            evict(nullptr, traces);
+        }
+        SessionImage::passProfilingTraces(traces);
+    }
+
+    void ImageResidency::add(SessionImage *image, bool reloaded) {
+        std::vector<ProfilingTrace> traces;
+        {
+            std::lock_guard<std::mutex> lock(s_mutex);
+            if (reloaded) {
+                s_reloads++;
+            }
+            if (auto it = s_positions.find(image); it != s_positions.end()) {
+                s_images.splice(s_images.begin(), s_images, it->second);
+            } else {
+                s_images.push_front(image);
+                s_positions.emplace(image, s_images.begin());
+                s_residentBytes += image->residentSize;
+            }
+            evict(image, traces);
+        }
+        SessionImage::passProfilingTraces(traces);
+    }
+
+    void ImageResidency::touch(SessionImage *image) {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        if (auto it = s_positions.find(image); it != s_positions.end()) {
+            s_images.splice(s_images.begin(), s_images, it->second);
+        }
+    }
+
+    void ImageResidency::remove(SessionImage *image) {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        auto it = s_positions.find(image);
+        if (it == s_positions.end()) {
+            return;
+        }
+        s_images.erase(it->second);
+        s_positions.erase(it);
+        s_residentBytes -= image->residentSize;
+    }
+
+    size_t ImageResidency::unloadIdle(std::chrono::steady_clock::time_point idleBefore) {
+        std::vector<ProfilingTrace> traces;
+        size_t count = 0;
+        {
+            std::lock_guard<std::mutex> lock(s_mutex);
+            for (auto it = s_images.begin(); it != s_images.end();) {
+                auto image = *it;
+                if (!image->tryUnload(traces, idleBefore)) {
+                    ++it;
+                    continue;
+                }
+                s_positions.erase(image);
+                it = s_images.erase(it);
+                s_residentBytes -= image->residentSize;
+                count++;
+            }
+        }
+        SessionImage::passProfilingTraces(traces);
+        return count;
+    }
+
+    ImageResidency::Statistics ImageResidency::statistics() {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        Statistics stats;
+        stats.residentImages = s_images.size();
+        stats.residentBytes = s_residentBytes;
+        stats.budget = s_budget;
+        stats.evictions = s_evictions;
+        stats.reloads = s_reloads;
+        return stats;
+    }
+
+    void ImageResidency::evict(SessionImage *keep, std::vector<ProfilingTrace> &traces) {
+        if (s_budget == 0) {
+            return;
+        }
+        auto it = s_images.end();
+        while (s_residentBytes > s_budget && it != s_images.begin()) {
+            --it;
+            auto image = *it;
+            // The images being loaded or run are skipped without waiting
+            if (image == keep || !image->tryUnload(traces)) {
+                continue;
+            }
+            Log.srtInfo("ImageResidency - Unloaded an idle image of %1 bytes", image->residentSize);
+            s_positions.erase(image);
+            it = s_images.erase(it);
+            s_residentBytes -= image->residentSize;
+            s_evictions++;
+        }
+    }
+
+}
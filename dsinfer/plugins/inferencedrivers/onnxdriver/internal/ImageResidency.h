@@ -0,0 +1,68 @@
+#ifndef DSINFER_ONNXDRIVER_IMAGERESIDENCY_H
+#define DSINFER_ONNXDRIVER_IMAGERESIDENCY_H
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ds::onnxdriver {
+
+    class SessionImage;
+    struct ProfilingTrace;
+
+    // Keeps the loaded session images within a memory budget.
+    //
+    // The loaded images are ordered by their last run. When the total estimated size exceeds
+    // the budget, the least recently run images that no run is using are unloaded, and they
+    // are loaded again by their next run.
+    class ImageResidency {
+    public:
+        struct Statistics {
+            size_t residentImages = 0;
+            uintmax_t residentBytes = 0;
+            uintmax_t budget = 0;
+            uint64_t evictions = 0;
+            uint64_t reloads = 0;
+        };
+
+        // Set the budget in bytes, 0 means unlimited.
+        static void setBudget(uintmax_t budget);
+
+        // Record a loaded image as the most recently run one, and unload the others over the
+        // budget.
+        static void add(SessionImage *image, bool reloaded);
+
+        // Record a run of a loaded image.
+        static void touch(SessionImage *image);
+
+        // Forget an image that is being destroyed.
+        static void remove(SessionImage *image);
+
+        // Unload the images whose last run finished before the given time. Returns the number
+        // of images unloaded.
+        static size_t unloadIdle(std::chrono::steady_clock::time_point idleBefore);
+
+        static Statistics statistics();
+
+    private:
+        // Must be called with the lock held, the traces of the unloaded images are appended to
+        // traces to be passed to the sink after the lock is released.
+        static void evict(SessionImage *keep, std::vector<ProfilingTrace> &traces);
+
+        // Front is the most recently run
+        static inline std::list<SessionImage *> s_images;
+        static inline std::unordered_map<SessionImage *, std::list<SessionImage *>::iterator>
+            s_positions;
+        static inline uintmax_t s_budget = 0;
+        static inline uintmax_t s_residentBytes = 0;
+        static inline uint64_t s_evictions = 0;
+        static inline uint64_t s_reloads = 0;
+        static inline std::mutex s_mutex;
+    };
+
+}
+
+#endif // DSINFER_ONNXDRIVER_IMAGERESIDENCY_H
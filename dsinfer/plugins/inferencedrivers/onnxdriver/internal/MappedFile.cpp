@@ -0,0 +1,152 @@
+#include "MappedFile.h"
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+#include <system_error>
+
+#ifdef _WIN32
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace ds::onnxdriver {
+
+    static std::string lastErrorString() {
+#ifdef _WIN32
+        return std::error_code(static_cast<int>(::GetLastError()), std::system_category())
+            .message();
+#else
+        return std::error_code(errno, std::system_category()).message();
+#endif
+    }
+
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile &&other) noexcept {
+        *this = std::move(other);
+    }
+
+    MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+        if (this == &other) {
+            return *this;
+        }
+        close();
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+        std::swap(_opened, other._opened);
+#ifdef _WIN32
+        std::swap(_mapping, other._mapping);
+#endif
+        return *this;
+    }
+
+    bool MappedFile::open(const std::filesystem::path &path, std::string *errorMessage) {
+        close();
+
+#ifdef _WIN32
+        HANDLE file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            if (errorMessage) {
+                *errorMessage = lastErrorString();
+            }
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!::GetFileSizeEx(file, &fileSize)) {
+            if (errorMessage) {
+                *errorMessage = lastErrorString();
+            }
+            ::CloseHandle(file);
+            return false;
+        }
+
+        if (fileSize.QuadPart > 0) {
+            // The mapping keeps the file open, so the file handle can be closed right away
+            HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!mapping) {
+                if (errorMessage) {
+                    *errorMessage = lastErrorString();
+                }
+                ::CloseHandle(file);
+                return false;
+            }
+            void *data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (!data) {
+                if (errorMessage) {
+                    *errorMessage = lastErrorString();
+                }
+                ::CloseHandle(mapping);
+                ::CloseHandle(file);
+                return false;
+            }
+            _mapping = mapping;
+            _data = data;
+            _size = static_cast<size_t>(fileSize.QuadPart);
+        }
+        ::CloseHandle(file);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            if (errorMessage) {
+                *errorMessage = lastErrorString();
+            }
+            return false;
+        }
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            if (errorMessage) {
+                *errorMessage = lastErrorString();
+            }
+            ::close(fd);
+            return false;
+        }
+
+        if (st.st_size > 0) {
+            // The mapping keeps the file open, so the descriptor can be closed right away
+            void *data = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED,
+                                fd, 0);
+            if (data == MAP_FAILED) {
+                if (errorMessage) {
+                    *errorMessage = lastErrorString();
+                }
+                ::close(fd);
+                return false;
+            }
+            _data = data;
+            _size = static_cast<size_t>(st.st_size);
+        }
+        ::close(fd);
+#endif
+        _opened = true;
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (_data) {
+#ifdef _WIN32
+            ::UnmapViewOfFile(_data);
+            ::CloseHandle(_mapping);
+            _mapping = nullptr;
+#else
+            ::munmap(_data, _size);
+#endif
+        }
+        _data = nullptr;
+        _size = 0;
+        _opened = false;
+    }
+
+}
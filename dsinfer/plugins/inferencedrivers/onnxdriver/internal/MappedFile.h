@@ -0,0 +1,50 @@
+#ifndef DSINFER_ONNXDRIVER_MAPPEDFILE_H
+#define DSINFER_ONNXDRIVER_MAPPEDFILE_H
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+
+namespace ds::onnxdriver {
+
+    // Read-only memory mapping of a whole file.
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        MappedFile(MappedFile &&other) noexcept;
+        MappedFile &operator=(MappedFile &&other) noexcept;
+
+    public:
+        bool open(const std::filesystem::path &path, std::string *errorMessage = nullptr);
+        void close();
+
+        inline bool isOpen() const {
+            return _opened;
+        }
+
+        // Empty files are mapped successfully with a null data pointer.
+        inline const std::byte *data() const {
+            return static_cast<const std::byte *>(_data);
+        }
+
+        inline size_t size() const {
+            return _size;
+        }
+
+    protected:
+        void *_data = nullptr;
+        size_t _size = 0;
+        bool _opened = false;
+#ifdef _WIN32
+        void *_mapping = nullptr;
+#endif
+    };
+
+}
+
+#endif // DSINFER_ONNXDRIVER_MAPPEDFILE_H
@@ -0,0 +1,358 @@
+#include "ModelCache.h"
+
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <set>
+#include <sstream>
+#include <system_error>
+
+#include <stdcorelib/path.h>
+
+#ifdef _MSC_VER
+#  include <intrin.h>
+#endif
+
+#include <blake3.h>
+
+#include "OnnxDriver_Logger.h"
+#include "SessionImage.h"
+
+namespace fs = std::filesystem;
+
+namespace ds::onnxdriver {
+
+    static constexpr char ENTRY_DIR_PREFIX[] = "onnxruntime-";
+    static constexpr char ENTRY_SUFFIX[] = ".ort";
+    static constexpr char TEMPORARY_SUFFIX[] = ".tmp";
+    static constexpr char HASH_INDEX_DIRNAME[] = "model-hashes";
+    static constexpr char HASH_RECORD_SUFFIX[] = ".txt";
+
+    // Other processes using the cache may still be writing the files younger than this
+    static constexpr auto ABANDONED_FILE_AGE = std::chrono::hours(1);
+
+    static std::string toHexString(const std::vector<uint8_t> &bytes) {
+        static constexpr char hexDigits[] = "0123456789abcdef";
+        std::string result(bytes.size() * 2, '0');
+        for (size_t i = 0; i < bytes.size(); ++i) {
+            result[2 * i] = hexDigits[bytes[i] >> 4];
+            result[2 * i + 1] = hexDigits[bytes[i] & 0x0f];
+        }
+        return result;
+    }
+
+    static bool fromHexString(const std::string &str, std::vector<uint8_t> &bytes) {
+        auto hexValue = [](char c) -> int {
+            if (c >= '0' && c <= '9')
+                return c - '0';
+            if (c >= 'a' && c <= 'f')
+                return c - 'a' + 10;
+            return -1;
+        };
+        if (str.empty() || str.size() % 2 != 0) {
+            return false;
+        }
+        bytes.resize(str.size() / 2);
+        for (size_t i = 0; i < bytes.size(); ++i) {
+            int hi = hexValue(str[2 * i]);
+            int lo = hexValue(str[2 * i + 1]);
+            if (hi < 0 || lo < 0) {
+                return false;
+            }
+            bytes[i] = static_cast<uint8_t>((hi << 4) | lo);
+        }
+        return true;
+    }
+
+    static std::string providerKey(Api::Onnx::ExecutionProvider ep) {
+        switch (ep) {
+            case Api::Onnx::CUDAExecutionProvider:
+                return "cuda";
+            case Api::Onnx::DMLExecutionProvider:
+                return "dml";
+            case Api::Onnx::CoreMLExecutionProvider:
+                return "coreml";
+            default:
+                return "cpu";
+        }
+    }
+
+    // The architecture and the instruction set extensions that ORT chooses its CPU kernels and
+    // layouts by.
+    static std::string cpuFeatureKey() {
+        static const std::string key = [] {
+            unsigned features = 0;
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+            features = (__builtin_cpu_supports("avx") ? 0x01 : 0) |
+                       (__builtin_cpu_supports("avx2") ? 0x02 : 0) |
+                       (__builtin_cpu_supports("fma") ? 0x04 : 0) |
+                       (__builtin_cpu_supports("avx512f") ? 0x08 : 0) |
+                       (__builtin_cpu_supports("avx512bw") ? 0x10 : 0) |
+                       (__builtin_cpu_supports("avx512vl") ? 0x20 : 0) |
+                       (__builtin_cpu_supports("avx512vnni") ? 0x40 : 0);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            int leaf1[4], leaf7[4];
+            __cpuid(leaf1, 1);
+            __cpuidex(leaf7, 7, 0);
+            features = ((leaf1[2] >> 28) & 1 ? 0x01 : 0) | ((leaf7[1] >> 5) & 1 ? 0x02 : 0) |
+                       ((leaf1[2] >> 12) & 1 ? 0x04 : 0) | ((leaf7[1] >> 16) & 1 ? 0x08 : 0) |
+                       ((leaf7[1] >> 30) & 1 ? 0x10 : 0) | ((leaf7[1] >> 31) & 1 ? 0x20 : 0) |
+                       ((leaf7[2] >> 11) & 1 ? 0x40 : 0);
+#endif
+#if defined(__x86_64__) || defined(_M_X64)
+            const char *arch = "x64";
+#elif defined(__i386__) || defined(_M_IX86)
+            const char *arch = "x86";
+#elif defined(__aarch64__) || defined(_M_ARM64)
+            const char *arch = "arm64";
+#else
+            const char *arch = "cpu";
+#endif
+            std::ostringstream stream;
+            stream << arch << '-' << std::hex << features;
+            return stream.str();
+        }();
+        return key;
+    }
+
+    static void removeStaleEntries(const fs::path &directory, const fs::path &versionDir) {
+        std::error_code ec;
+        for (const auto &entry : fs::directory_iterator(directory, ec)) {
+            const auto &path = entry.path();
+            auto name = path.filename().string();
+            if (!entry.is_directory(ec) || name.rfind(ENTRY_DIR_PREFIX, 0) != 0 ||
+                path == versionDir) {
+                continue;
+            }
+            Log.srtInfo("ModelCache - Removing entries of another runtime version: %1", path);
+            fs::remove_all(path, ec);
+        }
+    }
+
+    static bool isAbandoned(const fs::path &path) {
+        std::error_code ec;
+        auto modifiedTime = fs::last_write_time(path, ec);
+        return !ec && fs::file_time_type::clock::now() - modifiedTime > ABANDONED_FILE_AGE;
+    }
+
+    static void removeUnindexedEntries(const fs::path &versionDir,
+                                       const std::set<std::string> &indexedHashes) {
+        std::error_code ec;
+        for (const auto &entry : fs::directory_iterator(versionDir, ec)) {
+            const auto &path = entry.path();
+            if (!entry.is_regular_file(ec)) {
+                continue;
+            }
+            // Temporary files are left behind if the process died while writing an entry
+            if (path.extension() == TEMPORARY_SUFFIX) {
+                if (isAbandoned(path)) {
+                    fs::remove(path, ec);
+                }
+                continue;
+            }
+            // Entries of models that were modified or deleted are never hit again. A process
+            // opening a new model may have saved its entry after the index was read.
+            if (path.extension() != ENTRY_SUFFIX) {
+                continue;
+            }
+            auto name = path.filename().string();
+            if (indexedHashes.count(name.substr(0, name.find('.'))) == 0 && isAbandoned(path)) {
+                Log.srtInfo("ModelCache - Removing entry of an unknown model: %1", path);
+                fs::remove(path, ec);
+            }
+        }
+    }
+
+    // The record of a model file in the hash index, named after the hash of its path so that
+    // the processes sharing the cache never rewrite the records of each other.
+    static fs::path hashRecordPath(const fs::path &indexDir, const fs::path &modelPath) {
+        auto pathStr = stdc::path::to_utf8(modelPath);
+        std::vector<uint8_t> pathHash(16);
+        blake3_hasher hasher;
+        blake3_hasher_init(&hasher);
+        blake3_hasher_update(&hasher, pathStr.data(), pathStr.size());
+        blake3_hasher_finalize(&hasher, pathHash.data(), pathHash.size());
+        return indexDir / (toHexString(pathHash) + HASH_RECORD_SUFFIX);
+    }
+
+    // Each record is a line: <hash> <size> <modified time> <utf-8 path>
+    static bool readHashRecord(const fs::path &recordPath, fs::path &modelPath, uintmax_t &size,
+                               int64_t &modifiedTime, std::vector<uint8_t> &hash) {
+        std::ifstream file(recordPath);
+        std::string hashStr;
+        if (!(file >> hashStr >> size >> modifiedTime) || !fromHexString(hashStr, hash)) {
+            return false;
+        }
+        std::string pathStr;
+        std::getline(file >> std::ws, pathStr);
+        if (pathStr.empty()) {
+            return false;
+        }
+        modelPath = stdc::path::from_utf8(pathStr);
+        return true;
+    }
+
+    void ModelCache::initialize(const fs::path &directory, const std::string &runtimeVersion) {
+        std::unique_lock lock(s_mutex);
+        s_directory.clear();
+        s_hashIndexDir.clear();
+        if (directory.empty()) {
+            return;
+        }
+
+        auto versionDir = directory / (ENTRY_DIR_PREFIX + runtimeVersion);
+        std::error_code ec;
+        fs::create_directories(versionDir, ec);
+        if (ec) {
+            Log.srtWarning("ModelCache - Failed to create cache directory %1: %2", versionDir,
+                           ec.message());
+            return;
+        }
+        removeStaleEntries(directory, versionDir);
+
+        s_directory = versionDir;
+        Log.srtInfo("ModelCache - Using cache directory %1", s_directory);
+
+        s_hashIndexDir = directory / HASH_INDEX_DIRNAME;
+        fs::create_directories(s_hashIndexDir, ec);
+        if (ec) {
+            Log.srtWarning("ModelCache - Failed to create hash index directory %1: %2",
+                           s_hashIndexDir, ec.message());
+            s_hashIndexDir.clear();
+            return;
+        }
+
+        // The records of the models that no longer exist are dropped, the entries of the others
+        // are kept
+        std::set<std::string> indexedHashes;
+        for (const auto &entry : fs::directory_iterator(s_hashIndexDir, ec)) {
+            const auto &recordPath = entry.path();
+            if (recordPath.extension() == TEMPORARY_SUFFIX) {
+                if (isAbandoned(recordPath)) {
+                    fs::remove(recordPath, ec);
+                }
+                continue;
+            }
+            fs::path modelPath;
+            uintmax_t size;
+            int64_t modifiedTime;
+            std::vector<uint8_t> hash;
+            if (!readHashRecord(recordPath, modelPath, size, modifiedTime, hash)) {
+                continue;
+            }
+            if (!fs::exists(modelPath, ec)) {
+                fs::remove(recordPath, ec);
+                continue;
+            }
+            indexedHashes.insert(toHexString(hash));
+        }
+        removeUnindexedEntries(versionDir, indexedHashes);
+    }
+
+    bool ModelCache::isEnabled() {
+        std::shared_lock lock(s_mutex);
+        return !s_directory.empty();
+    }
+
+    fs::path ModelCache::entryPath(const std::vector<uint8_t> &modelHash,
+                                   const SessionImageOptions &options,
+                                   Api::Onnx::ExecutionProvider ep) {
+        std::shared_lock lock(s_mutex);
+        if (s_directory.empty() || modelHash.empty()) {
+            return {};
+        }
+        // Only the provider and the optimization level change the graph saved by ORT. Thread
+        // and execution settings are applied again when the entry is loaded.
+        auto name = toHexString(modelHash) + "." + providerKey(ep) + ".O" +
+                    std::to_string(static_cast<int>(options.graphOptimizationLevel));
+        // The layout transforms of the highest level are chosen for the instruction sets of the
+        // CPU, the entry is not valid on another one
+        if (options.graphOptimizationLevel == Api::Onnx::AllGraphOptimization) {
+            name += "." + cpuFeatureKey();
+        }
+        name += ENTRY_SUFFIX;
+        return s_directory / name;
+    }
+
+    fs::path ModelCache::temporaryPath(const fs::path &entryPath) {
+        static std::mutex randomMutex;
+        static std::mt19937_64 random(std::random_device{}());
+
+        uint64_t token;
+        {
+            std::lock_guard lock(randomMutex);
+            token = random();
+        }
+        auto path = entryPath;
+        path += "." + std::to_string(token) + TEMPORARY_SUFFIX;
+        return path;
+    }
+
+    bool ModelCache::commit(const fs::path &temporaryPath, const fs::path &entryPath) {
+        std::error_code ec;
+        fs::rename(temporaryPath, entryPath, ec);
+        if (ec) {
+            Log.srtWarning("ModelCache - Failed to commit entry %1: %2", entryPath, ec.message());
+            fs::remove(temporaryPath, ec);
+            return false;
+        }
+        Log.srtDebug("ModelCache - Saved entry %1", entryPath);
+        return true;
+    }
+
+    void ModelCache::remove(const fs::path &path) {
+        std::error_code ec;
+        fs::remove(path, ec);
+    }
+
+    bool ModelCache::findModelHash(const fs::path &path, uintmax_t size, int64_t modifiedTime,
+                                   std::vector<uint8_t> &hash) {
+        std::shared_lock lock(s_mutex);
+        if (s_hashIndexDir.empty()) {
+            return false;
+        }
+        // Read from the disk every time, another process may have hashed the model meanwhile
+        fs::path recordModelPath;
+        uintmax_t recordSize;
+        int64_t recordModifiedTime;
+        std::vector<uint8_t> recordHash;
+        if (!readHashRecord(hashRecordPath(s_hashIndexDir, path), recordModelPath, recordSize,
+                            recordModifiedTime, recordHash) ||
+            recordModelPath != path || recordSize != size || recordModifiedTime != modifiedTime) {
+            return false;
+        }
+        hash = std::move(recordHash);
+        return true;
+    }
+
+    void ModelCache::saveModelHash(const fs::path &path, uintmax_t size, int64_t modifiedTime,
+                                   const std::vector<uint8_t> &hash) {
+        std::shared_lock lock(s_mutex);
+        if (s_hashIndexDir.empty()) {
+            return;
+        }
+
+        // Replace the record atomically, the processes hashing the same model at once write the
+        // same content
+        auto recordPath = hashRecordPath(s_hashIndexDir, path);
+        auto temporaryPath = ModelCache::temporaryPath(recordPath);
+        {
+            std::ofstream file(temporaryPath, std::ios::trunc);
+            file << toHexString(hash) << ' ' << size << ' ' << modifiedTime << ' '
+                 << stdc::path::to_utf8(path) << '\n';
+            if (!file) {
+                Log.srtWarning("ModelCache - Failed to write hash record %1", recordPath);
+                std::error_code ec;
+                fs::remove(temporaryPath, ec);
+                return;
+            }
+        }
+        std::error_code ec;
+        fs::rename(temporaryPath, recordPath, ec);
+        if (ec) {
+            fs::remove(temporaryPath, ec);
+        }
+    }
+
+}
@@ -0,0 +1,70 @@
+#ifndef DSINFER_ONNXDRIVER_MODELCACHE_H
+#define DSINFER_ONNXDRIVER_MODELCACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include <dsinfer/Api/Drivers/Onnx/OnnxDriverApi.h>
+
+namespace ds::onnxdriver {
+
+    struct SessionImageOptions;
+
+    // On-disk cache of ORT-optimized models.
+    //
+    // Entries are stored in ORT format under a directory named after the runtime version, so
+    // that upgrading the runtime invalidates all of them at once:
+    //
+    //     <directory>/onnxruntime-<version>/<model hash>.<provider>.<options key>.ort
+    //
+    // The cache also records the hashes of the model files by (path, size, modification time),
+    // so that unchanged models are not hashed again in later processes. Each model has a record
+    // of its own, so that the processes sharing the cache do not overwrite each other:
+    //
+    //     <directory>/model-hashes/<path hash>.txt
+    class ModelCache {
+    public:
+        // Enable the cache and remove the entries left by other runtime versions, as well as
+        // those of models that are no longer in the hash index. The files that another process
+        // may still be writing are kept. An empty directory disables the cache.
+        static void initialize(const std::filesystem::path &directory,
+                               const std::string &runtimeVersion);
+
+        static bool isEnabled();
+
+        // Returns the entry path of the model optimized for the provider, or an empty path if
+        // the cache is disabled.
+        static std::filesystem::path entryPath(const std::vector<uint8_t> &modelHash,
+                                               const SessionImageOptions &options,
+                                               Api::Onnx::ExecutionProvider ep);
+
+        // Returns a unique path to write a new entry to before committing it.
+        static std::filesystem::path temporaryPath(const std::filesystem::path &entryPath);
+
+        // Atomically move a finished temporary file to its entry path.
+        static bool commit(const std::filesystem::path &temporaryPath,
+                           const std::filesystem::path &entryPath);
+
+        // Remove a stale or broken entry, ignoring errors.
+        static void remove(const std::filesystem::path &path);
+
+        // Returns true and sets the hash if the model file has been hashed before and has not
+        // changed since.
+        static bool findModelHash(const std::filesystem::path &path, uintmax_t size,
+                                  int64_t modifiedTime, std::vector<uint8_t> &hash);
+
+        static void saveModelHash(const std::filesystem::path &path, uintmax_t size,
+                                  int64_t modifiedTime, const std::vector<uint8_t> &hash);
+
+    private:
+        static inline std::filesystem::path s_directory;
+        static inline std::filesystem::path s_hashIndexDir;
+        static inline std::shared_mutex s_mutex;
+    };
+
+}
+
+#endif // DSINFER_ONNXDRIVER_MODELCACHE_H
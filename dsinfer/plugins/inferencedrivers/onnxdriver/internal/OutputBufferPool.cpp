@@ -0,0 +1,110 @@
+#include "OutputBufferPool.h"
+
+#include <algorithm>
+
+namespace ds::onnxdriver {
+
+    namespace {
+
+        // A tensor that gives its buffer back to the pool it came from.
+        class PooledTensor : public Tensor {
+        public:
+            PooledTensor(std::weak_ptr<OutputBufferPool> pool, std::string name,
+                         DataType dataType, std::vector<int64_t> shape,
+                         Container &&buffer)
+                : _pool(std::move(pool)), _name(std::move(name)) {
+                _dataType = dataType;
+                _shape = std::move(shape);
+                _data = std::make_shared<Container>(std::move(buffer));
+            }
+
+            ~PooledTensor() override {
+                // Clones still sharing the buffer keep it
+                if (_data.use_count() != 1) {
+                    return;
+                }
+                if (auto pool = _pool.lock()) {
+                    pool->recycle(_name, std::move(*_data));
+                }
+            }
+
+        protected:
+            std::weak_ptr<OutputBufferPool> _pool;
+            std::string _name;
+        };
+
+    }
+
+    srt::NO<Tensor> OutputBufferPool::acquire(const std::string &name,
+                                              ITensor::DataType dataType,
+                                              const std::vector<int64_t> &shape,
+                                              size_t byteSize) {
+        // ORT writes the whole output, growing the buffer need not zero it
+        Tensor::Container buffer(Tensor::Container::allocator_type::uninitialized());
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (auto it = _idleBuffers.find(name); it != _idleBuffers.end()) {
+                auto &buffers = it->second;
+                if (!buffers.empty()) {
+                    // Prefer the smallest buffer that fits, otherwise grow the largest one
+                    auto best = buffers.end();
+                    for (auto it2 = buffers.begin(); it2 != buffers.end(); ++it2) {
+                        if (it2->capacity() >= byteSize) {
+                            if (best == buffers.end() || it2->capacity() < best->capacity()) {
+                                best = it2;
+                            }
+                        }
+                    }
+                    if (best == buffers.end()) {
+                        best = std::max_element(buffers.begin(), buffers.end(),
+                                                [](const auto &a, const auto &b) {
+                                                    return a.capacity() < b.capacity();
+                                                });
+                    }
+                    buffer = std::move(*best);
+                    buffers.erase(best);
+                }
+            }
+        }
+        buffer.resize(byteSize);
+        return srt::NO<PooledTensor>::create(weak_from_this(), name, dataType, shape,
+                                             std::move(buffer));
+    }
+
+    void OutputBufferPool::recycle(const std::string &name, Tensor::Container &&buffer) {
+        if (buffer.capacity() == 0) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto &buffers = _idleBuffers[name];
+        if (buffers.size() < MAX_IDLE_BUFFERS) {
+            buffers.push_back(std::move(buffer));
+            return;
+        }
+        // Keep the largest buffers
+        auto smallest = std::min_element(buffers.begin(), buffers.end(),
+                                         [](const auto &a, const auto &b) {
+                                             return a.capacity() < b.capacity();
+                                         });
+        if (smallest->capacity() < buffer.capacity()) {
+            *smallest = std::move(buffer);
+        }
+    }
+
+    void OutputBufferPool::exclude(const std::string &name) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _excludedNames.insert(name);
+        _idleBuffers.erase(name);
+    }
+
+    bool OutputBufferPool::isExcluded(const std::string &name) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _excludedNames.count(name) != 0;
+    }
+
+    void OutputBufferPool::clear() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _idleBuffers.clear();
+    }
+
+}
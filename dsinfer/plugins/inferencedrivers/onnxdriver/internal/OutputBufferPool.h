@@ -0,0 +1,48 @@
+#ifndef DSINFER_ONNXDRIVER_OUTPUTBUFFERPOOL_H
+#define DSINFER_ONNXDRIVER_OUTPUTBUFFERPOOL_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <dsinfer/Core/Tensor.h>
+
+namespace ds::onnxdriver {
+
+    // Per-session pool of output buffers, keyed by the output name.
+    //
+    // The tensors handed out return their buffers to the pool when they are destroyed, so
+    // that repeated runs of similar sizes write into memory that is already allocated and
+    // touched. Buffers keep the capacity of the largest output seen (high-water mark).
+    class OutputBufferPool : public std::enable_shared_from_this<OutputBufferPool> {
+    public:
+        // Maximum number of idle buffers kept for each output.
+        static constexpr size_t MAX_IDLE_BUFFERS = 4;
+
+        OutputBufferPool() = default;
+
+        // Returns a tensor backed by a pooled buffer. The contents are unspecified.
+        srt::NO<Tensor> acquire(const std::string &name, ITensor::DataType dataType,
+                                const std::vector<int64_t> &shape, size_t byteSize);
+
+        void recycle(const std::string &name, Tensor::Container &&buffer);
+
+        // Stop pooling an output whose shape could not be resolved correctly before running,
+        // and free its idle buffers. ORT allocates it from then on.
+        void exclude(const std::string &name);
+        bool isExcluded(const std::string &name);
+
+        void clear();
+
+    protected:
+        std::mutex _mutex;
+        std::map<std::string, std::vector<Tensor::Container>> _idleBuffers;
+        std::set<std::string> _excludedNames;
+    };
+
+}
+
+#endif // DSINFER_ONNXDRIVER_OUTPUTBUFFERPOOL_H
@@ -0,0 +1,48 @@
+#include "ProcessMemory.h"
+
+#ifdef _WIN32
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#  include <psapi.h>
+#elif defined(__APPLE__)
+#  include <mach/mach.h>
+#else
+#  include <cstdio>
+#  include <unistd.h>
+#endif
+
+namespace ds::onnxdriver {
+
+    uintmax_t processResidentMemory() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (!::GetProcessMemoryInfo(::GetCurrentProcess(), &counters, sizeof(counters))) {
+            return 0;
+        }
+        return counters.WorkingSetSize;
+#elif defined(__APPLE__)
+        mach_task_basic_info_data_t info;
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+        if (::task_info(::mach_task_self(), MACH_TASK_BASIC_INFO,
+                        reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS) {
+            return 0;
+        }
+        return info.resident_size;
+#else
+        FILE *file = std::fopen("/proc/self/statm", "r");
+        if (!file) {
+            return 0;
+        }
+        unsigned long long size = 0, resident = 0;
+        int n = std::fscanf(file, "%llu %llu", &size, &resident);
+        std::fclose(file);
+        if (n != 2) {
+            return 0;
+        }
+        return static_cast<uintmax_t>(resident) * static_cast<uintmax_t>(::sysconf(_SC_PAGESIZE));
+#endif
+    }
+
+}
@@ -0,0 +1,13 @@
+#ifndef DSINFER_ONNXDRIVER_PROCESSMEMORY_H
+#define DSINFER_ONNXDRIVER_PROCESSMEMORY_H
+
+#include <cstdint>
+
+namespace ds::onnxdriver {
+
+    // Returns the resident memory of the current process in bytes, or 0 if unavailable.
+    uintmax_t processResidentMemory();
+
+}
+
+#endif // DSINFER_ONNXDRIVER_PROCESSMEMORY_H
@@ -0,0 +1,67 @@
+#include "RunWatchdog.h"
+
+namespace ds::onnxdriver {
+
+    RunWatchdog::~RunWatchdog() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _quit = true;
+        }
+        _cv.notify_all();
+        if (_thread.joinable()) {
+            _thread.join();
+        }
+    }
+
+    RunWatchdog &RunWatchdog::global() {
+        static RunWatchdog instance;
+        return instance;
+    }
+
+    int64_t RunWatchdog::add(Clock::time_point deadline, Ort::RunOptions *runOptions) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (!_thread.joinable()) {
+            _thread = std::thread(&RunWatchdog::watch, this);
+        }
+        auto id = _nextId++;
+        auto it = _deadlines.emplace(deadline, Entry{id, runOptions});
+        _entries.emplace(id, it);
+        bool earliest = it == _deadlines.begin();
+        lock.unlock();
+
+        if (earliest) {
+            _cv.notify_all();
+        }
+        return id;
+    }
+
+    void RunWatchdog::remove(int64_t id) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _entries.find(id);
+        if (it == _entries.end()) {
+            return;
+        }
+        _deadlines.erase(it->second);
+        _entries.erase(it);
+    }
+
+    void RunWatchdog::watch() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (!_quit) {
+            if (_deadlines.empty()) {
+                _cv.wait(lock);
+                continue;
+            }
+            auto it = _deadlines.begin();
+            if (Clock::now() < it->first) {
+                _cv.wait_until(lock, it->first);
+                continue;
+            }
+            // Terminated under the lock, so that the run options stay valid
+            it->second.runOptions->SetTerminate();
+            _entries.erase(it->second.id);
+            _deadlines.erase(it);
+        }
+    }
+
+}
@@ -0,0 +1,51 @@
+#ifndef DSINFER_ONNXDRIVER_RUNWATCHDOG_H
+#define DSINFER_ONNXDRIVER_RUNWATCHDOG_H
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include <onnxruntime_cxx_api.h>
+
+namespace ds::onnxdriver {
+
+    // Terminates the runs that pass their deadlines. The watch thread is started by the first
+    // deadline.
+    class RunWatchdog {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        ~RunWatchdog();
+
+        static RunWatchdog &global();
+
+        // Returns an id for removing the deadline.
+        int64_t add(Clock::time_point deadline, Ort::RunOptions *runOptions);
+
+        // Once it returns, the run options are no longer used.
+        void remove(int64_t id);
+
+    protected:
+        RunWatchdog() = default;
+
+        void watch();
+
+        struct Entry {
+            int64_t id;
+            Ort::RunOptions *runOptions;
+        };
+
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        std::multimap<Clock::time_point, Entry> _deadlines;
+        std::map<int64_t, decltype(_deadlines)::iterator> _entries;
+        int64_t _nextId = 1;
+        bool _quit = false;
+        std::thread _thread;
+    };
+
+}
+
+#endif // DSINFER_ONNXDRIVER_RUNWATCHDOG_H
@@ -1,15 +1,19 @@
 #include "Session.h"
 
 #include <cassert>
+#include <chrono>
 #include <cstddef>
+#include <future>
 #include <mutex>
 #include <shared_mutex>
 #include <sstream>
-#include <fstream>
+#include <string_view>
 #include <unordered_set>
 #include <algorithm>
 #include <list>
+#include <optional>
 #include <numeric>
+#include <thread>
 
 #include <stdcorelib/path.h>
 #include <stdcorelib/pimpl.h>
@@ -19,9 +23,19 @@
 
 #include <blake3.h>
 
+#include <dsinfer/Core/TensorView.h>
+
 #include "OnnxDriver_Logger.h"
 #include "SessionImage.h"
 #include "ScopedTimer.h"
+#include "MappedFile.h"
+#include "ModelCache.h"
+#include "OutputBufferPool.h"
+#include "ShapeBucketing.h"
+#include "RunWatchdog.h"
+#include "ArenaTrimming.h"
+#include "Env.h"
+#include "ThreadAffinity.h"
 
 #include "OnnxTensor.h"
 
@@ -31,16 +45,24 @@ namespace fs = std::filesystem;
 namespace ds::onnxdriver {
 
     struct SessionSystem {
+        struct LoadResult {
+            std::shared_ptr<SessionImage> image; // null if failed
+            std::string error;
+        };
+
         struct ImageData {
-            SessionImage *image;
+            // Published before the image is loaded, so that concurrent openers of the same
+            // image wait for the first one to finish loading
+            std::shared_future<LoadResult> future;
             int count;
         };
 
         struct ImageGroup {
             std::filesystem::path path;
+            std::vector<std::filesystem::path> aliases; // other paths of the same model
             std::streamsize size = 0;
             std::vector<uint8_t> hash;
-            std::map<int, ImageData> images; // hint -> [ image, count ]
+            std::map<SessionImageOptions, ImageData> images; // options -> [ image, count ]
         };
 
         struct HashSizeKey {
@@ -63,14 +85,81 @@ namespace ds::onnxdriver {
         std::map<std::filesystem::path::string_type, ListIterator> path_map;
         std::map<HashSizeKey, ListIterator> hash_size_map;
 
+        // Only guards the containers above, images are loaded without holding it.
         std::shared_mutex mtx;
 
+        // Decrease the reference count of an image and remove it when it reaches zero, as well
+        // as the group if it becomes empty. Must be called with the lock held. Returns the
+        // remaining reference count.
+        int release(ImageGroup &group, const SessionImageOptions &options) {
+            auto &images = group.images;
+            auto it = images.find(options);
+            assert(it != images.end());
+            auto count = --it->second.count;
+            if (count != 0) {
+                return count;
+            }
+            images.erase(it);
+
+            if (images.empty()) {
+                auto it2 = hash_size_map.find({group.size, group.hash});
+                assert(it2 != hash_size_map.end());
+
+                auto list_it = it2->second;
+
+                hash_size_map.erase(it2);
+                path_map.erase(group.path);
+                for (const auto &alias : group.aliases) {
+                    path_map.erase(alias);
+                }
+                image_list.erase(list_it);
+            }
+            return 0;
+        }
+
         static SessionSystem &global() {
             static SessionSystem instance;
             return instance;
         }
     };
 
+    // State shared by a session and its runs in flight. Asynchronous runs may complete after
+    // the session has been closed or destroyed, so they hold their own reference.
+    struct SessionRunState {
+        std::mutex mutex;
+
+        // Run options of the runs in flight, used to terminate them
+        std::unordered_set<Ort::RunOptions *> activeRuns;
+
+        // Result of the latest finished run
+        srt::NO<Api::Onnx::SessionResult> lastResult;
+
+        SessionRunState() : lastResult(srt::NO<Api::Onnx::SessionResult>::create()) {
+        }
+
+        void setLastResult(srt::NO<Api::Onnx::SessionResult> result) {
+            std::lock_guard<std::mutex> lock(mutex);
+            lastResult = std::move(result);
+        }
+
+        void setLastError(const srt::Error &error) {
+            auto result = srt::NO<Api::Onnx::SessionResult>::create();
+            result->error = error;
+            setLastResult(std::move(result));
+        }
+    };
+
+    // The compiled form of a binding plan. The name pointers refer to the port names of the
+    // image, which stay valid as long as the image is alive.
+    class CompiledBindingPlan : public Api::Onnx::SessionBindingPlan {
+    public:
+        std::weak_ptr<SessionImage> image;
+        std::vector<const char *> inputNames;
+        std::vector<const char *> outputNames;
+    };
+
+    // Everything a single run needs. Each call owns its own context, so that multiple threads
+    // can run the same session at once.
     struct SessionRunContext {
         std::vector<const char *> inputNames;
         std::vector<const char *> outputNames;
@@ -79,6 +168,14 @@ namespace ds::onnxdriver {
         // Each value will be automatically cleaned up.
         std::vector<Ort::Value> inputValueRegistry;
 
+        // Holds references to the input tensors, in the order of inputNames. Ort::Value objects
+        // created without copying borrow the tensor buffers, so the tensors must outlive the run.
+        std::vector<srt::NO<ITensor>> inputTensors;
+
+        // Clones of the base tensors of the input views, which hold the buffers the views
+        // refer to.
+        std::vector<srt::NO<ITensor>> inputBuffers;
+
         // OrtValue pointers for ORT api use. The vector does not own the values.
         std::vector<OrtValue *> inputValuePtrs;
 
@@ -86,6 +183,25 @@ namespace ds::onnxdriver {
         // The vector does not own the values, so they need manually memory management.
         std::vector<OrtValue *> outputValuePtrs;
 
+        // The binding plan the inputs are bound by slot with, null if bound by name. The
+        // outputs are collected into the slots as well.
+        srt::NO<CompiledBindingPlan> plan;
+
+        // Keeps the image alive and loaded until the run completes, and the replica of it that
+        // the run is dispatched to.
+        std::shared_ptr<SessionImage> image;
+        Ort::Session *session = nullptr;
+
+        // Per-run options, so that terminating the session reaches every run in flight.
+        Ort::RunOptions runOptions;
+        std::shared_ptr<SessionRunState> state;
+
+        // Terminate only this run when cancelled or past the deadline
+        std::shared_ptr<CancellationToken> cancellationToken;
+        std::optional<RunWatchdog::Clock::time_point> deadline;
+        int cancellationId = 0;
+        int64_t watchdogId = 0;
+
         SessionRunContext() = default;
 
         explicit SessionRunContext(size_t inputSize, size_t outputSize)
@@ -93,6 +209,7 @@ namespace ds::onnxdriver {
             inputNames.reserve(inputSize);
             outputNames.reserve(outputSize);
             inputValueRegistry.reserve(inputSize);
+            inputTensors.reserve(inputSize);
             inputValuePtrs.reserve(inputSize);
         }
 
@@ -101,24 +218,57 @@ namespace ds::onnxdriver {
         SessionRunContext &operator=(const SessionRunContext &) = delete;
 
         ~SessionRunContext() {
+            deactivate();
             releaseOutputValues();
+            if (session) {
+                image->release(session);
+            }
         }
 
-        void initialize(size_t inputSize, size_t outputSize) {
-            inputNames.clear();
-            inputNames.reserve(inputSize);
-
-            outputNames.clear();
-            outputNames.reserve(outputSize);
-
-            inputValueRegistry.clear();
-            inputValueRegistry.reserve(inputSize);
+        // Register the run so that it can be terminated.
+        void activate(const std::shared_ptr<SessionRunState> &runState) {
+            state = runState;
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->activeRuns.insert(&runOptions);
+            }
+            if (cancellationToken) {
+                cancellationId = cancellationToken->subscribe([this] { runOptions.SetTerminate(); });
+            }
+            if (deadline) {
+                watchdogId = RunWatchdog::global().add(*deadline, &runOptions);
+            }
+        }
 
-            inputValuePtrs.clear();
-            inputValuePtrs.reserve(inputSize);
+        void deactivate() {
+            if (!state) {
+                return;
+            }
+            if (cancellationId) {
+                cancellationToken->unsubscribe(cancellationId);
+                cancellationId = 0;
+            }
+            if (watchdogId) {
+                RunWatchdog::global().remove(watchdogId);
+                watchdogId = 0;
+            }
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->activeRuns.erase(&runOptions);
+            }
+            state.reset();
+            ArenaTrimming::global().endRun();
+        }
 
-            releaseOutputValues();
-            outputValuePtrs.resize(outputSize, nullptr);
+        // Returns the error of a failed run, telling whether it was terminated for this run.
+        srt::Error runError(const std::string &message) const {
+            if (cancellationToken && cancellationToken->isCancelled()) {
+                return {srt::Error::SessionError, "run cancelled"};
+            }
+            if (deadline && RunWatchdog::Clock::now() >= *deadline) {
+                return {srt::Error::SessionError, "run deadline exceeded"};
+            }
+            return {srt::Error::SessionError, message};
         }
 
         void releaseOutputValues() {
@@ -131,25 +281,31 @@ namespace ds::onnxdriver {
         }
     };
 
-    struct SessionAsyncRunContext {
+    struct SessionAsyncRunContext : public SessionRunContext {
+        using SessionRunContext::SessionRunContext;
+
         srt::ITask::StartAsyncCallback callback;
+
+        // The bucketed dimensions to trim the outputs to
+        BucketedDimensions bucketedDimensions;
     };
 
     class Session::Impl {
     public:
-        Ort::RunOptions runOptions;
-
         SessionSystem::ImageGroup *group = nullptr;
-        SessionImage *image = nullptr;
-        int hints = 0;
+        std::shared_ptr<SessionImage> image;
+        SessionImageOptions options;
 
         std::filesystem::path realPath;
 
-        std::unique_ptr<SessionRunContext> context;
-        std::unique_ptr<SessionAsyncRunContext> asyncContext;
-        srt::NO<Api::Onnx::SessionResult> sessionResult;
+        std::shared_ptr<SessionRunState> runState;
 
-        Impl() : sessionResult(srt::NO<Api::Onnx::SessionResult>::create()) {
+        // Pool of output buffers reused across runs, null if disabled
+        std::shared_ptr<OutputBufferPool> outputPool;
+
+        ShapeBucketingPolicy bucketingPolicy;
+
+        Impl() : runState(std::make_shared<SessionRunState>()) {
         }
 
         static inline size_t getTensorDataTypeSize(ITensor::DataType type) {
@@ -160,6 +316,10 @@ namespace ds::onnxdriver {
                     return sizeof(int64_t);
                 case ITensor::Bool:
                     return sizeof(bool);
+                case ITensor::Float16:
+                    return sizeof(Float16);
+                case ITensor::BFloat16:
+                    return sizeof(BFloat16);
                 default:
                     return 0; // error
             }
@@ -173,6 +333,10 @@ namespace ds::onnxdriver {
                 return ITensor::Int64;
             } else if constexpr (std::is_same_v<T, bool>) {
                 return ITensor::Bool;
+            } else if constexpr (std::is_same_v<T, Float16>) {
+                return ITensor::Float16;
+            } else if constexpr (std::is_same_v<T, BFloat16>) {
+                return ITensor::BFloat16;
             } else {
                 static_assert(sizeof(T) == 0, "Unsupported type for getTensorDType");
                 return ITensor::Float; // fallback to avoid warnings, won't compile anyway due to
@@ -180,6 +344,40 @@ namespace ds::onnxdriver {
             }
         }
 
+        static inline ONNXTensorElementDataType getOnnxElementType(ITensor::DataType type) {
+            switch (type) {
+                case ITensor::Float:
+                    return ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT;
+                case ITensor::Int64:
+                    return ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64;
+                case ITensor::Bool:
+                    return ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL;
+                case ITensor::Float16:
+                    return ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16;
+                case ITensor::BFloat16:
+                    return ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16;
+                default:
+                    return ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED; // error
+            }
+        }
+
+        static inline ITensor::DataType getTensorDataType(ONNXTensorElementDataType type) {
+            switch (type) {
+                case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+                    return ITensor::Float;
+                case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+                    return ITensor::Int64;
+                case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+                    return ITensor::Bool;
+                case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+                    return ITensor::Float16;
+                case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+                    return ITensor::BFloat16;
+                default:
+                    return ITensor::Undefined; // error
+            }
+        }
+
         template <typename T>
         static inline Ort::Value
             _createOrtValueFromTensorImpl(const std::byte *rawBuffer, const size_t dataLength,
@@ -195,7 +393,7 @@ namespace ds::onnxdriver {
 
         static inline Ort::Value createOrtValueFromTensor(const srt::NO<ITensor> &tensor,
                                                           const Ort::MemoryInfo &memoryInfo,
-                                                          srt::Error *error = nullptr) {
+                                                          bool copy, srt::Error *error = nullptr) {
             const auto &rawBuffer = tensor->rawData();
             const auto dtype = tensor->dataType();
             auto shape = tensor->shape();
@@ -208,6 +406,23 @@ namespace ds::onnxdriver {
                 }
                 return Ort::Value(nullptr);
             }
+
+            // Wrap the tensor buffer directly. ORT never writes to input buffers, so the const
+            // cast is safe; the caller keeps the tensor alive until the run completes.
+            // Empty tensors may have no buffer at all, let ORT allocate them instead.
+            if (!copy && rawBuffer && tensor->byteSize() > 0) {
+                auto onnxType = getOnnxElementType(dtype);
+                if (onnxType == ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED) {
+                    if (error) {
+                        *error = {srt::Error::InvalidArgument, "Unsupported data type"};
+                    }
+                    return Ort::Value(nullptr);
+                }
+                return Ort::Value::CreateTensor(
+                    memoryInfo, const_cast<std::byte *>(rawBuffer), tensor->byteSize(),
+                    shape.data(), shape.size(), onnxType);
+            }
+
             switch (dtype) {
                 case ITensor::Float:
                     return _createOrtValueFromTensorImpl<float>(rawBuffer, dataLength, shape);
@@ -216,6 +431,15 @@ namespace ds::onnxdriver {
                                                                   shape);
                 case ITensor::Bool:
                     return _createOrtValueFromTensorImpl<bool>(rawBuffer, dataLength, shape);
+                case ITensor::Float16:
+                case ITensor::BFloat16: {
+                    auto ortTensor = Ort::Value::CreateTensor(
+                        Ort::AllocatorWithDefaultOptions{}, shape.data(), shape.size(),
+                        getOnnxElementType(dtype));
+                    std::memcpy(ortTensor.GetTensorMutableRawData(), rawBuffer,
+                                tensor->byteSize());
+                    return ortTensor;
+                }
                 default:
                     if (error) {
                         *error = {srt::Error::InvalidArgument, "Unsupported data type"};
@@ -254,6 +478,14 @@ namespace ds::onnxdriver {
                     tensorType = ITensor::Bool;
                     elementSize = sizeof(bool);
                     break;
+                case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+                    tensorType = ITensor::Float16;
+                    elementSize = sizeof(Float16);
+                    break;
+                case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+                    tensorType = ITensor::BFloat16;
+                    elementSize = sizeof(BFloat16);
+                    break;
                 default:
                     if (error) {
                         *error = {srt::Error::InvalidArgument,
@@ -334,41 +566,443 @@ namespace ds::onnxdriver {
             return {}; // no error
         }
 
-        static void runAsyncCallback(void *user_data, OrtValue **outputs, size_t num_outputs,
-                                     OrtStatusPtr status) {
-            auto &impl = *static_cast<Impl *>(user_data);
-            auto &ctx = *impl.context;
-            impl.sessionResult->outputs.clear();
-            Ort::Status runStatus(status);
-            if (!runStatus.IsOK()) {
-                impl.sessionResult->error = {srt::Error::SessionError, runStatus.GetErrorMessage()};
-                impl.asyncContext->callback(impl.sessionResult, impl.sessionResult->error);
-                srtCritical("runAsyncCallback failed");
-                return;
+        // Checks the slots of a run against its binding plan, which has been validated against
+        // the model when created. Returns the compiled plan in \a plan.
+        inline srt::Error validateBindingPlan(const Api::Onnx::SessionStartInput &input,
+                                              srt::NO<CompiledBindingPlan> &plan) const {
+            plan = input.bindingPlan.as<CompiledBindingPlan>();
+            if (!plan || plan->image.lock() != image) {
+                return {srt::Error::SessionError,
+                        "binding plan was not created by this session"};
+            }
+            if (input.inputSlots.size() != plan->inputNames.size()) {
+                return {srt::Error::SessionError,
+                        "expected " + std::to_string(plan->inputNames.size()) +
+                            " input slot(s), got " + std::to_string(input.inputSlots.size())};
+            }
+            for (size_t i = 0; i < input.inputSlots.size(); ++i) {
+                if (!input.inputSlots[i]) {
+                    return {srt::Error::SessionError, "input slot \"" +
+                                                          std::string(plan->inputNames[i]) +
+                                                          "\" is null"};
+                }
             }
-            for (size_t i = 0; i < num_outputs; ++i) {
+            return {};
+        }
+
+        inline srt::Error validateInput(const srt::NO<Api::Onnx::SessionStartInput> &input,
+                                        srt::NO<CompiledBindingPlan> &plan) {
+            if (input->bindingPlan) {
+                return validateBindingPlan(*input, plan);
+            }
+            return validateInputValueMap(input);
+        }
+
+        // Collects the output values of a finished run into the result. The ownership of the
+        // values is transferred to the result tensors.
+        static inline bool collectOutputs(SessionRunContext &ctx, OrtValue **outputs,
+                                          size_t outputCount,
+                                          Api::Onnx::SessionResult &result,
+                                          srt::Error *error = nullptr) {
+            for (size_t i = 0; i < outputCount; ++i) {
                 // Transfer ownership of the raw OrtValue* to an Ort::Value wrapper,
-                // which will subsequently be managed by OnnxTensor. No manual release is required.
+                // which will subsequently be managed by OnnxTensor. No manual release is
+                // required.
                 Ort::Value managedOrtValue(outputs[i]);
 
-                // Null the raw pointer to prevent double release in SessionRunContext's destructor.
+                // Null the raw pointer to prevent double release in SessionRunContext's
+                // destructor.
                 outputs[i] = nullptr;
 
                 auto exp = OnnxTensor::createFromOrtValue(std::move(managedOrtValue));
                 if (!exp) {
-                    impl.sessionResult->error = exp.takeError();
-                    impl.asyncContext->callback(impl.sessionResult, impl.sessionResult->error);
-                    return;
+                    if (error) {
+                        *error = exp.takeError();
+                    }
+                    return false;
                 }
+                if (ctx.plan) {
+                    result.outputSlots.push_back(exp.take());
+                } else {
+                    result.outputs.emplace(ctx.outputNames[i], exp.take());
+                }
+            }
+            return true;
+        }
 
-                impl.sessionResult->outputs.emplace(
-                    ctx.outputNames[i],
-                    exp.take());
+        static void runAsyncCallback(void *user_data, OrtValue **outputs, size_t num_outputs,
+                                     OrtStatusPtr status) {
+            // The context was released to ORT when the run started, take it back
+            std::unique_ptr<SessionAsyncRunContext> ctx(
+                static_cast<SessionAsyncRunContext *>(user_data));
+            auto state = ctx->state;
+            ctx->deactivate();
+
+            auto result = srt::NO<Api::Onnx::SessionResult>::create();
+            Ort::Status runStatus(status);
+            if (!runStatus.IsOK()) {
+                result->error = ctx->runError(runStatus.GetErrorMessage());
+                srtCritical("runAsyncCallback failed");
+            } else if (collectOutputs(*ctx, outputs, num_outputs, *result, &result->error)) {
+                if (auto exp = trimOutputs(*ctx->image, ctx->bucketedDimensions, *result,
+                                           ctx->plan.get());
+                    !exp) {
+                    result->error = exp.takeError();
+                }
             }
-            impl.asyncContext->callback(impl.sessionResult, impl.sessionResult->error);
+
+            auto callback = std::move(ctx->callback);
+            ctx.reset();
+
+            state->setLastResult(result);
+            callback(result, result->error);
             srtDebug("runAsyncCallback completed");
         }
 
+        // Pads the inputs if shape bucketing is enabled. The output buffers given by the caller
+        // must have the exact shapes, so the inputs are left alone in that case.
+        inline srt::NO<Api::Onnx::SessionStartInput>
+            bucketInputs(const srt::NO<Api::Onnx::SessionStartInput> &sessionStartInput,
+                         BucketedDimensions &dimensions, srt::Error *error) {
+            if (!bucketingPolicy.isEnabled() || !sessionStartInput->outputBuffers.empty()) {
+                return sessionStartInput;
+            }
+            auto exp = padInputs(bucketingPolicy, *image, sessionStartInput, dimensions);
+            if (!exp) {
+                if (error) {
+                    *error = exp.takeError();
+                }
+                return {};
+            }
+            return exp.take();
+        }
+
+        // Adds an input tensor to the run context, converting it to an ORT value if needed.
+        static inline bool bindInput(SessionRunContext &ctx, const char *name,
+                                     const srt::NO<ITensor> &value,
+                                     const Ort::MemoryInfo &memInfo, bool copy,
+                                     srt::Error *error) {
+            ctx.inputNames.push_back(name);
+            const auto backend = value->backend();
+            if (backend == Tensor::BACKEND || backend == TensorView::BACKEND) {
+                // Contiguous views are bound in place like tensors, the others are gathered
+                // into a tensor first, which the run context keeps alive instead.
+                //
+                // Keeping the tensor alive is not enough for its buffer: if the caller writes to
+                // a tensor whose buffer is shared with clones, the tensor moves to a copy, and
+                // the bound buffer is freed with the last clone. Tensors are therefore bound
+                // through a clone of their own, and views keep a clone of their base tensor.
+                bool gathered = !value->isContiguous();
+                auto tensor = gathered || backend == Tensor::BACKEND ? value->clone() : value;
+                if (!gathered && backend == TensorView::BACKEND) {
+                    if (auto base = value.as<TensorView>()->base();
+                        base && base->backend() == Tensor::BACKEND) {
+                        ctx.inputBuffers.push_back(base->clone());
+                    }
+                }
+                ctx.inputTensors.push_back(tensor);
+                auto ortValue =
+                    tensor ? createOrtValueFromTensor(tensor, memInfo, copy && !gathered, error)
+                           : Ort::Value(nullptr);
+                if (!ortValue) {
+                    if (error) {
+                        *error = {srt::Error::InvalidArgument,
+                                  "Could not create Ort Tensor for input name \"" +
+                                      std::string(name) + "\""};
+                    }
+                    return false;
+                }
+                ctx.inputValueRegistry.push_back(std::move(ortValue));
+                ctx.inputValuePtrs.push_back(ctx.inputValueRegistry.back());
+            } else if (backend == "onnx") {
+                ctx.inputTensors.push_back(value);
+                auto ortValue = value.as<OnnxTensor>();
+                ctx.inputValuePtrs.push_back(*(ortValue->valuePtr()));
+            } else {
+                if (error) {
+                    *error = {srt::Error::InvalidArgument,
+                              "Unknown tensor backend for input name \"" + std::string(name) +
+                                  "\""};
+                }
+                return false;
+            }
+            return true;
+        }
+
+        // Validates the start input and fills the run context with the inputs and outputs.
+        // With a binding plan in the context, the inputs are taken from the slots instead.
+        inline bool prepareRun(const srt::NO<Api::Onnx::SessionStartInput> &sessionStartInput,
+                               SessionRunContext &ctx, srt::Error *error) {
+            ctx.image = image;
+            std::string message;
+            ctx.session = ctx.image->acquire(&message);
+            if (!ctx.session) {
+                if (error) {
+                    *error = {srt::Error::SessionError, "failed to reload model: " + message};
+                }
+                return false;
+            }
+            ctx.cancellationToken = sessionStartInput->cancellationToken;
+            ctx.deadline = sessionStartInput->deadline;
+
+            auto memInfo = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+            bool copy = sessionStartInput->copyInputs;
+            if (ctx.plan) {
+                const auto &slots = sessionStartInput->inputSlots;
+                for (size_t i = 0; i < slots.size(); ++i) {
+                    if (!bindInput(ctx, ctx.plan->inputNames[i], slots[i], memInfo, copy, error)) {
+                        return false;
+                    }
+                }
+                ctx.outputNames = ctx.plan->outputNames;
+                return true;
+            }
+
+            for (auto &[name, value] : sessionStartInput->inputs) {
+                if (!bindInput(ctx, name.c_str(), value, memInfo, copy, error)) {
+                    return false;
+                }
+            }
+            for (auto &name : sessionStartInput->outputs) {
+                ctx.outputNames.push_back(name.c_str());
+            }
+            return true;
+        }
+
+        // Resolves the shape of an output before running, by matching its symbolic dimensions
+        // with the dimensions of the inputs. Returns false if any dimension is unknown.
+        //
+        // ONNX does not require the dimensions of the same name to be equal at run time, so the
+        // shape is only a guess, see runWithBinding().
+        static bool resolveOutputShape(const SessionImage &image,
+                                       const SessionImage::PortInfo &outputInfo,
+                                       const SessionRunContext &ctx,
+                                       std::vector<int64_t> &shape) {
+            shape.clear();
+            shape.reserve(outputInfo.shape.size());
+            for (size_t i = 0; i < outputInfo.shape.size(); ++i) {
+                if (outputInfo.shape[i] >= 0) {
+                    shape.push_back(outputInfo.shape[i]);
+                    continue;
+                }
+                if (i >= outputInfo.symbolicShape.size() || outputInfo.symbolicShape[i].empty()) {
+                    return false;
+                }
+                const auto &symbol = outputInfo.symbolicShape[i];
+                int64_t dim = -1;
+                for (size_t j = 0; j < image.inputNames.size() && dim < 0; ++j) {
+                    const auto &inputSymbols = image.inputInfos[j].symbolicShape;
+                    auto it = std::find(inputSymbols.begin(), inputSymbols.end(), symbol);
+                    if (it == inputSymbols.end()) {
+                        continue;
+                    }
+                    // The inputs bound to the run context, by name or by slot
+                    auto it2 = std::find_if(ctx.inputNames.begin(), ctx.inputNames.end(),
+                                            [&name = image.inputNames[j]](const char *input) {
+                                                return name == input;
+                                            });
+                    if (it2 == ctx.inputNames.end()) {
+                        continue;
+                    }
+                    auto inputShape = ctx.inputTensors[it2 - ctx.inputNames.begin()]->shape();
+                    auto axis = static_cast<size_t>(it - inputSymbols.begin());
+                    if (axis < inputShape.size()) {
+                        dim = inputShape[axis];
+                    }
+                }
+                if (dim < 0) {
+                    return false;
+                }
+                shape.push_back(dim);
+            }
+            return true;
+        }
+
+        // Returns a pooled tensor for the output if its shape is known before running.
+        inline srt::NO<ITensor>
+            acquirePooledOutput(const SessionImage &image, const std::string &name,
+                                const SessionRunContext &ctx) {
+            auto it = std::find(image.outputNames.begin(), image.outputNames.end(), name);
+            if (it == image.outputNames.end() || outputPool->isExcluded(name)) {
+                return {};
+            }
+            const auto &outputInfo = image.outputInfos[it - image.outputNames.begin()];
+            auto dataType = getTensorDataType(outputInfo.type);
+            if (dataType == ITensor::Undefined) {
+                return {};
+            }
+            std::vector<int64_t> shape;
+            if (!resolveOutputShape(image, outputInfo, ctx, shape)) {
+                return {};
+            }
+            auto byteSize = getTensorDataTypeSize(dataType);
+            for (const auto dim : shape) {
+                byteSize *= static_cast<size_t>(dim);
+            }
+            if (byteSize == 0) {
+                return {};
+            }
+            return outputPool->acquire(name, dataType, shape, byteSize);
+        }
+
+        static inline bool isShapeMismatch(const Ort::Exception &e) {
+            return std::string_view(e.what()).find("Shape mismatch") != std::string_view::npos;
+        }
+
+        // Runs through an IoBinding, so that the outputs are written straight into the buffers
+        // given by the caller or taken from the pool. The other outputs are allocated by ORT.
+        //
+        // The shapes of the pooled outputs are guessed before running. If ORT rejects one, the
+        // run is repeated with the pooled outputs allocated by ORT, and the outputs whose guess
+        // turned out wrong are no longer pooled.
+        inline bool runWithBinding(const srt::NO<Api::Onnx::SessionStartInput> &sessionStartInput,
+                                   SessionRunContext &ctx, Api::Onnx::SessionResult &result,
+                                   srt::Error *error) {
+            const auto &api = Ort::GetApi();
+            auto &session = *ctx.session;
+            auto memInfo = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+            const auto &outputBuffers = sessionStartInput->outputBuffers;
+
+            // Tensors bound as outputs, null for the outputs allocated by ORT
+            std::vector<srt::NO<ITensor>> boundTensors(ctx.outputNames.size());
+            std::vector<Ort::Value> boundValues;
+            boundValues.reserve(ctx.outputNames.size());
+
+            // The guessed shapes of the pooled outputs of the first attempt
+            std::vector<std::vector<int64_t>> guessedShapes(ctx.outputNames.size());
+            bool usePool = outputPool != nullptr;
+
+            std::optional<Ort::IoBinding> binding;
+            for (;;) {
+                binding.emplace(session);
+                if (!bindOutputs(*binding, sessionStartInput, ctx, memInfo, usePool,
+                                 boundTensors, boundValues, guessedShapes, error)) {
+                    return false;
+                }
+                try {
+                    session.Run(ctx.runOptions, *binding);
+                    break;
+                } catch (const Ort::Exception &e) {
+                    bool pooled = std::any_of(guessedShapes.begin(), guessedShapes.end(),
+                                              [](const auto &shape) { return !shape.empty(); });
+                    if (!usePool || !pooled || !isShapeMismatch(e)) {
+                        throw;
+                    }
+                    Log.srtDebug("Session [%1] - Pooled output shape mismatch, running again: %2",
+                                 realPath.filename(), e.what());
+                }
+                usePool = false;
+                boundTensors.assign(ctx.outputNames.size(), {});
+                boundValues.clear();
+            }
+
+            // The values are in the order of binding
+            auto outputValues = binding->GetOutputValues();
+            auto addOutput = [&](size_t i, srt::NO<ITensor> tensor) {
+                if (ctx.plan) {
+                    result.outputSlots.push_back(std::move(tensor));
+                } else {
+                    result.outputs.emplace(ctx.outputNames[i], std::move(tensor));
+                }
+            };
+            for (size_t i = 0; i < ctx.outputNames.size(); ++i) {
+                if (boundTensors[i]) {
+                    addOutput(i, std::move(boundTensors[i]));
+                    continue;
+                }
+                if (!usePool && !guessedShapes[i].empty() &&
+                    outputValues[i].GetTensorTypeAndShapeInfo().GetShape() != guessedShapes[i]) {
+                    Log.srtDebug("Session [%1] - Output \"%2\" is no longer pooled",
+                                 realPath.filename(), ctx.outputNames[i]);
+                    outputPool->exclude(ctx.outputNames[i]);
+                }
+                auto exp = OnnxTensor::createFromOrtValue(std::move(outputValues[i]));
+                if (!exp) {
+                    if (error) {
+                        *error = exp.takeError();
+                    }
+                    return false;
+                }
+                addOutput(i, exp.take());
+            }
+            return true;
+        }
+
+        // Binds the inputs of the run context and the outputs to an IoBinding. The outputs are
+        // bound to the buffers given by the caller, or taken from the pool if usePool is set,
+        // and are allocated by ORT otherwise.
+        inline bool bindOutputs(Ort::IoBinding &binding,
+                                const srt::NO<Api::Onnx::SessionStartInput> &sessionStartInput,
+                                SessionRunContext &ctx, const Ort::MemoryInfo &memInfo,
+                                bool usePool, std::vector<srt::NO<ITensor>> &boundTensors,
+                                std::vector<Ort::Value> &boundValues,
+                                std::vector<std::vector<int64_t>> &guessedShapes,
+                                srt::Error *error) {
+            const auto &api = Ort::GetApi();
+            for (size_t i = 0; i < ctx.inputNames.size(); ++i) {
+                Ort::ThrowOnError(
+                    api.BindInput(binding, ctx.inputNames[i], ctx.inputValuePtrs[i]));
+            }
+
+            const auto &outputBuffers = sessionStartInput->outputBuffers;
+            for (size_t i = 0; i < ctx.outputNames.size(); ++i) {
+                const char *name = ctx.outputNames[i];
+                srt::NO<ITensor> tensor;
+                if (auto it = outputBuffers.find(name); it != outputBuffers.end()) {
+                    tensor = it->second;
+                } else if (usePool) {
+                    tensor = acquirePooledOutput(*ctx.image, name, ctx);
+                    if (tensor) {
+                        guessedShapes[i] = tensor->shape();
+                    }
+                }
+
+                if (!tensor || tensor->byteSize() == 0) {
+                    binding.BindOutput(name, memInfo);
+                    continue;
+                }
+
+                if (tensor->backend() == "onnx") {
+                    Ort::ThrowOnError(
+                        api.BindOutput(binding, name, *(tensor.as<OnnxTensor>()->valuePtr())));
+                } else if (tensor->backend() == Tensor::BACKEND ||
+                           tensor->backend() == TensorView::BACKEND) {
+                    // ORT writes the outputs densely, so a view must be contiguous
+                    if (!tensor->isContiguous()) {
+                        if (error) {
+                            *error = {srt::Error::InvalidArgument,
+                                      "Non-contiguous buffer for output name \"" +
+                                          std::string(name) + "\""};
+                        }
+                        return false;
+                    }
+                    auto onnxType = getOnnxElementType(tensor->dataType());
+                    if (onnxType == ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED) {
+                        if (error) {
+                            *error = {srt::Error::InvalidArgument,
+                                      "Unsupported data type for output name \"" +
+                                          std::string(name) + "\""};
+                        }
+                        return false;
+                    }
+                    auto shape = tensor->shape();
+                    boundValues.push_back(Ort::Value::CreateTensor(
+                        memInfo, tensor->mutableRawData(), tensor->byteSize(), shape.data(),
+                        shape.size(), onnxType));
+                    binding.BindOutput(name, boundValues.back());
+                } else {
+                    if (error) {
+                        *error = {srt::Error::InvalidArgument,
+                                  "Unknown tensor backend for output name \"" +
+                                      std::string(name) + "\""};
+                    }
+                    return false;
+                }
+                boundTensors[i] = std::move(tensor);
+            }
+            return true;
+        }
+
         inline srt::NO<Api::Onnx::SessionResult> sessionRun(const srt::NO<Api::Onnx::SessionStartInput> &sessionStartInput,
                                srt::Error *error = nullptr) {
             const auto &filename = realPath.filename();
@@ -391,7 +1025,8 @@ namespace ds::onnxdriver {
                 return {};
             }
 
-            if (auto validateError = validateInputValueMap(sessionStartInput);
+            srt::NO<CompiledBindingPlan> plan;
+            if (auto validateError = validateInput(sessionStartInput, plan);
                 !validateError.ok()) {
                 if (error) {
                     *error = std::move(validateError);
@@ -400,86 +1035,75 @@ namespace ds::onnxdriver {
                 return {};
             }
 
-            const auto &inputValueMap = sessionStartInput->inputs;
-            auto inputCount = inputValueMap.size();
-            auto outputCount = sessionStartInput->outputs.size();
+            BucketedDimensions bucketedDimensions;
+            auto runInput = bucketInputs(sessionStartInput, bucketedDimensions, error);
+            if (!runInput) {
+                timer.deactivate();
+                return {};
+            }
 
-            context = std::make_unique<SessionRunContext>(inputCount, outputCount);
-            auto &ctx = *context;
+            auto inputCount = plan ? plan->inputNames.size() : runInput->inputs.size();
+            auto outputCount = plan ? plan->outputNames.size() : runInput->outputs.size();
+
+            SessionRunContext ctx(inputCount, outputCount);
+            ctx.plan = plan;
 
             auto result = srt::NO<Api::Onnx::SessionResult>::create();
             try {
-                auto memInfo = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
-
-                for (auto &[name, value] : inputValueMap) {
-                    ctx.inputNames.push_back(name.c_str());
-                    if (value->backend() == "tensor") {
-                        auto ortValue = createOrtValueFromTensor(value, memInfo, error);
-                        if (!ortValue) {
-                            if (error) {
-                                *error = {srt::Error::InvalidArgument,
-                                          "Could not create Ort Tensor for input name \"" + name +
-                                              "\""};
-                            }
-                            return {};
-                        }
-                        ctx.inputValueRegistry.push_back(std::move(ortValue));
-                        ctx.inputValuePtrs.push_back(ctx.inputValueRegistry.back());
-                    } else if (value->backend() == "onnx") {
-                        auto ortValue = value.as<OnnxTensor>();
-                        ctx.inputValuePtrs.push_back(*(ortValue->valuePtr()));
-                    } else {
+                if (!prepareRun(runInput, ctx, error)) {
+                    return {};
+                }
+                // The calling thread runs its share of the work too, but ORT does not pin it
+                ScopedThreadAffinity affinity(ctx.image->callerCore(ctx.session));
+
+                if (outputPool || !runInput->outputBuffers.empty()) {
+                    ctx.activate(runState);
+                    bool ok = runWithBinding(runInput, ctx, *result, error);
+                    ctx.deactivate();
+                    if (!ok) {
+                        return {};
+                    }
+                    if (auto exp = trimOutputs(*ctx.image, bucketedDimensions, *result,
+                                               plan.get());
+                        !exp) {
                         if (error) {
-                            *error = {srt::Error::InvalidArgument,
-                                      "Unknown tensor backend for input name \"" + name + "\""};
+                            *error = exp.takeError();
                         }
                         return {};
                     }
+                    return result;
                 }
 
-                for (auto &name : sessionStartInput->outputs) {
-                    ctx.outputNames.push_back(name.c_str());
-                }
-                runOptions.UnsetTerminate();
-
+                ctx.activate(runState);
                 Ort::Status statusRun(Ort::GetApi().Run(
-                    image->session, runOptions, ctx.inputNames.data(), ctx.inputValuePtrs.data(),
-                    inputCount, ctx.outputNames.data(), outputCount, ctx.outputValuePtrs.data()));
+                    *ctx.session, ctx.runOptions, ctx.inputNames.data(),
+                    ctx.inputValuePtrs.data(), inputCount, ctx.outputNames.data(), outputCount,
+                    ctx.outputValuePtrs.data()));
+                ctx.deactivate();
 
                 if (!statusRun.IsOK()) {
                     ctx.releaseOutputValues();
                     if (error) {
-                        *error = srt::Error(srt::Error::SessionError, statusRun.GetErrorMessage());
+                        *error = ctx.runError(statusRun.GetErrorMessage());
                     }
                     return {};
                 }
 
-                for (size_t i = 0; i < ctx.outputValuePtrs.size(); ++i) {
-                    // Transfer ownership of the raw OrtValue* to an Ort::Value wrapper,
-                    // which will subsequently be managed by OnnxTensor. No manual release is
-                    // required.
-                    Ort::Value managedOrtValue(ctx.outputValuePtrs[i]);
-
-                    // Null the raw pointer to prevent double release in SessionRunContext's
-                    // destructor.
-                    ctx.outputValuePtrs[i] = nullptr;
-
-                    auto exp = OnnxTensor::createFromOrtValue(std::move(managedOrtValue));
-                    if (!exp) {
-                        if (error) {
-                            *error = exp.takeError();
-                        }
-                        return {};
+                if (!collectOutputs(ctx, ctx.outputValuePtrs.data(), ctx.outputValuePtrs.size(),
+                                    *result, error)) {
+                    return {};
+                }
+                if (auto exp = trimOutputs(*ctx.image, bucketedDimensions, *result, plan.get());
+                    !exp) {
+                    if (error) {
+                        *error = exp.takeError();
                     }
-                    result->outputs.emplace(
-                        ctx.outputNames[i],
-                        exp.take());
+                    return {};
                 }
-                sessionResult = result;
                 return result;
             } catch (const Ort::Exception &err) {
                 if (error) {
-                    *error = srt::Error(srt::Error::SessionError, err.what());
+                    *error = ctx.runError(err.what());
                 }
             }
             timer.deactivate();
@@ -509,7 +1133,8 @@ namespace ds::onnxdriver {
                 return false;
             }
 
-            if (auto validateError = validateInputValueMap(sessionStartInput);
+            srt::NO<CompiledBindingPlan> plan;
+            if (auto validateError = validateInput(sessionStartInput, plan);
                 !validateError.ok()) {
                 if (error) {
                     *error = std::move(validateError);
@@ -518,64 +1143,59 @@ namespace ds::onnxdriver {
                 return false;
             }
 
-            const auto &inputValueMap = sessionStartInput->inputs;
-            auto inputCount = inputValueMap.size();
-            auto outputCount = sessionStartInput->outputs.size();
-
-            context = std::make_unique<SessionRunContext>(inputCount, outputCount);
-            auto &ctx = *context;
+            auto inputCount = plan ? plan->inputNames.size() : sessionStartInput->inputs.size();
+            auto outputCount = plan ? plan->outputNames.size() : sessionStartInput->outputs.size();
 
-            asyncContext = std::make_unique<SessionAsyncRunContext>();
+            auto ctx = std::make_unique<SessionAsyncRunContext>(inputCount, outputCount);
+            ctx->plan = plan;
+            auto runInput = bucketInputs(sessionStartInput, ctx->bucketedDimensions, error);
+            if (!runInput) {
+                timer.deactivate();
+                return false;
+            }
             try {
-                auto memInfo = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
-
-                for (auto &[name, value] : inputValueMap) {
-                    ctx.inputNames.push_back(name.c_str());
-                    if (value->backend() == "tensor") {
-                        auto ortValue = createOrtValueFromTensor(value, memInfo, error);
-                        if (!ortValue) {
-                            if (error) {
-                                *error = {srt::Error::InvalidArgument,
-                                          "Could not create Ort Tensor for input name \"" + name +
-                                              "\""};
-                            }
-                            return false;
-                        }
-                        ctx.inputValueRegistry.push_back(std::move(ortValue));
-                        ctx.inputValuePtrs.push_back(ctx.inputValueRegistry.back());
-                    } else if (value->backend() == "onnx") {
-                        auto ortValue = value.as<OnnxTensor>();
-                        ctx.inputValuePtrs.push_back(*(ortValue->valuePtr()));
-                    } else {
-                        if (error) {
-                            *error = {srt::Error::InvalidArgument,
-                                      "Unknown tensor backend for input name \"" + name + "\""};
-                        }
-                        return false;
-                    }
+                if (!prepareRun(runInput, *ctx, error)) {
+                    return false;
                 }
 
-                for (auto &name : sessionStartInput->outputs) {
-                    ctx.outputNames.push_back(name.c_str());
+                ctx->callback = callback;
+                ctx->activate(runState);
+
+                // The callback takes the ownership of the context once the run has started
+                auto &ctxRef = *ctx;
+                if (!image->canRunAsync) {
+                    // RunAsync() fails without an intra-op pool to queue the run to, so the run
+                    // is done on a thread of its own instead, and completed the same way.
+                    std::thread([ctx = ctx.get(), inputCount, outputCount]() {
+                        OrtStatusPtr status;
+                        {
+                            ScopedThreadAffinity affinity(ctx->image->callerCore(ctx->session));
+                            status = Ort::GetApi().Run(
+                                *ctx->session, ctx->runOptions, ctx->inputNames.data(),
+                                ctx->inputValuePtrs.data(), inputCount, ctx->outputNames.data(),
+                                outputCount, ctx->outputValuePtrs.data());
+                        }
+                        runAsyncCallback(ctx, ctx->outputValuePtrs.data(), outputCount, status);
+                    }).detach();
+                    ctx.release();
+                    return true;
                 }
-                runOptions.UnsetTerminate();
-
-                asyncContext->callback = callback;
                 Ort::Status statusRun(Ort::GetApi().RunAsync(
-                    image->session, runOptions, ctx.inputNames.data(), ctx.inputValuePtrs.data(),
-                    inputCount, ctx.outputNames.data(), outputCount, ctx.outputValuePtrs.data(),
-                    runAsyncCallback, static_cast<void *>(this)));
+                    *ctxRef.session, ctxRef.runOptions, ctxRef.inputNames.data(),
+                    ctxRef.inputValuePtrs.data(), inputCount, ctxRef.outputNames.data(),
+                    outputCount, ctxRef.outputValuePtrs.data(), runAsyncCallback,
+                    static_cast<void *>(ctx.get())));
                 if (!statusRun.IsOK()) {
-                    ctx.releaseOutputValues();
                     if (error) {
-                        *error = srt::Error(srt::Error::SessionError, statusRun.GetErrorMessage());
+                        *error = ctx->runError(statusRun.GetErrorMessage());
                     }
                     return false;
                 }
+                ctx.release();
                 return true;
             } catch (const Ort::Exception &err) {
                 if (error) {
-                    *error = srt::Error(srt::Error::SessionError, err.what());
+                    *error = ctx->runError(err.what());
                 }
             }
             timer.deactivate();
@@ -586,6 +1206,101 @@ namespace ds::onnxdriver {
     Session::Session() : _impl(std::make_unique<Impl>()) {
     }
 
+    // Returns the images of the given models that are done opening, or of all open models if
+    // none is given.
+    static std::vector<std::pair<std::filesystem::path, std::shared_ptr<SessionImage>>>
+        openImages(const std::vector<std::filesystem::path> &models) {
+        std::vector<std::pair<std::filesystem::path, std::shared_ptr<SessionImage>>> images;
+        {
+            auto &session_system = SessionSystem::global();
+            std::shared_lock<std::shared_mutex> lock(session_system.mtx);
+            std::vector<const SessionSystem::ImageGroup *> groups;
+            if (models.empty()) {
+                for (const auto &group : session_system.image_list) {
+                    groups.push_back(&group);
+                }
+            } else {
+                for (const auto &model : models) {
+                    std::error_code ec;
+                    auto canonical_path = fs::canonical(model, ec);
+                    if (ec) {
+                        continue;
+                    }
+                    if (auto it = session_system.path_map.find(canonical_path);
+                        it != session_system.path_map.end() &&
+                        std::find(groups.begin(), groups.end(), &(*it->second)) ==
+                            groups.end()) {
+                        groups.push_back(&(*it->second));
+                    }
+                }
+            }
+            for (const auto *pGroup : groups) {
+                const auto &group = *pGroup;
+                for (const auto &[options, data] : group.images) {
+                    // Skip the images still being loaded
+                    if (data.future.wait_for(std::chrono::seconds(0)) !=
+                        std::future_status::ready) {
+                        continue;
+                    }
+                    if (const auto &image = data.future.get().image) {
+                        images.emplace_back(group.path, image);
+                    }
+                }
+            }
+        }
+        return images;
+    }
+
+    int Session::warmUpImages(int64_t length, const std::vector<std::filesystem::path> &models) {
+        auto images = openImages(models);
+
+        std::vector<std::future<bool>> futures;
+        futures.reserve(images.size());
+        for (const auto &[path, image] : images) {
+            futures.push_back(std::async(std::launch::async, [&path = path, &image = image,
+                                                              length] {
+                const auto &filename = path.filename();
+                Log.srtDebug("SessionImage [%1] - warming up", filename);
+                if (std::string message; !image->warmUp(length, &message)) {
+                    Log.srtWarning("SessionImage [%1] - warm-up failed: %2", filename, message);
+                    return false;
+                }
+                return true;
+            }));
+        }
+
+        int count = 0;
+        for (auto &future : futures) {
+            count += future.get() ? 1 : 0;
+        }
+        return count;
+    }
+
+    int Session::shrinkArenas(std::chrono::steady_clock::time_point idleBefore) {
+        auto images = openImages({});
+        bool sharedArena = Env::useSharedCpuAllocator();
+        bool sharedArenaShrunk = false;
+        int count = 0;
+        for (const auto &[path, image] : images) {
+            if (!image->canShrinkArenas(idleBefore)) {
+                continue;
+            }
+            if (sharedArenaShrunk) {
+                image->setArenasShrunk();
+                continue;
+            }
+            Log.srtDebug("SessionImage [%1] - shrinking arenas", path.filename());
+            if (std::string message; !image->shrinkArenas(&message)) {
+                Log.srtWarning("SessionImage [%1] - arena shrinking failed: %2", path.filename(),
+                               message);
+                continue;
+            }
+            count++;
+            sharedArenaShrunk = sharedArena;
+        }
+        return count;
+    }
+
     Session::~Session() {
         close();
     }
@@ -604,31 +1319,47 @@ namespace ds::onnxdriver {
 
     static bool getFileInfo(const fs::path &path, std::vector<uint8_t> &binaryResult,
                             std::string &stringResult, std::streamsize &sizeResult) {
-        std::ifstream file(path, std::ios::binary);
-        if (!file) {
+        std::error_code ec;
+        auto fileSize = fs::file_size(path, ec);
+        if (ec) {
             return false;
         }
-
-        // get size
-        file.seekg(0, std::ios::end);
-        sizeResult = file.tellg();
-        file.seekg(0, std::ios::beg);
-
-        static constexpr const size_t buffer_size = 4096; // Process 4KB each time
-        char buffer[buffer_size];
-
-        blake3_hasher hasher;
-        blake3_hasher_init(&hasher);
-
-        while (file.read(buffer, buffer_size) || file.gcount() > 0) {
-            blake3_hasher_update(&hasher, buffer, file.gcount());
+        auto modifiedTime =
+            static_cast<int64_t>(fs::last_write_time(path, ec).time_since_epoch().count());
+        if (ec) {
+            return false;
         }
+        sizeResult = static_cast<std::streamsize>(fileSize);
 
         constexpr size_t hashByteSize = 32;
 
-        // get binary
-        binaryResult.resize(hashByteSize);
-        blake3_hasher_finalize(&hasher, binaryResult.data(), binaryResult.size());
+        // Unchanged models are not hashed again
+        if (!ModelCache::findModelHash(path, fileSize, modifiedTime, binaryResult)) {
+            // Hash the mapped file in place instead of copying it through a stream buffer
+            MappedFile file;
+            if (!file.open(path)) {
+                return false;
+            }
+
+            blake3_hasher hasher;
+            blake3_hasher_init(&hasher);
+#ifdef BLAKE3_USE_TBB
+            // Hash the subtrees of large inputs on multiple threads
+            blake3_hasher_update_tbb(&hasher, file.data(), file.size());
+#else
+            blake3_hasher_update(&hasher, file.data(), file.size());
+#endif
+
+            // get binary
+            binaryResult.resize(hashByteSize);
+            blake3_hasher_finalize(&hasher, binaryResult.data(), binaryResult.size());
+
+            // The file may have been replaced between the stat and the mapping
+            sizeResult = static_cast<std::streamsize>(file.size());
+            if (file.size() == fileSize) {
+                ModelCache::saveModelHash(path, fileSize, modifiedTime, binaryResult);
+            }
+        }
 
         // get string
         static constexpr char hexDigits[] = "0123456789abcdef";
@@ -661,36 +1392,23 @@ namespace ds::onnxdriver {
 
         // Ready to load
         auto &session_system = SessionSystem::global();
-        std::unique_lock<std::shared_mutex> lock(session_system.mtx);
-        SessionImage *image = nullptr;
         std::vector<uint8_t> hash;
-        std::streamsize size;
+        std::streamsize size = 0;
+
+        auto options = SessionImageOptions::fromOpenArgs(*args);
 
-        int hints = SH_NoHint;
-        if (args->useCpu) {
-            hints |= SH_PreferCPUHint;
-        }
         // Search path
-        SessionSystem::ImageGroup *image_group = nullptr;
-        if (auto it = session_system.path_map.find(canonical_path);
-            it != session_system.path_map.end()) {
-            image_group = &(*it->second);
-            auto &image_map = image_group->images;
-            if (auto it2 = image_map.find(hints); it2 != image_map.end()) {
-                auto &data = it2->second;
-                image = data.image;
-                data.count++;
-                goto out_exists;
+        {
+            std::shared_lock<std::shared_mutex> lock(session_system.mtx);
+            if (auto it = session_system.path_map.find(canonical_path);
+                it != session_system.path_map.end()) {
+                hash = it->second->hash;
+                size = it->second->size;
             }
-            hash = it->second->hash;
-            size = it->second->size;
-
-            Log.srtDebug("Session - No same hint in opened sessions");
-            goto out_search_hash;
         }
 
-        // Calculate hash
-        {
+        // Calculate hash, without holding the lock
+        if (hash.empty()) {
             std::string hash_str;
             if (!getFileInfo(canonical_path, hash, hash_str, size)) {
                 return srt::Error(srt::Error::FileNotOpen, "failed to read file");
@@ -698,35 +1416,20 @@ namespace ds::onnxdriver {
             Log.srtDebug("Session - BLAKE3 hash is %1", hash_str);
         }
 
-        // Search hash
-        if (auto it = session_system.hash_size_map.find({size, hash});
-            it != session_system.hash_size_map.end()) {
-            image_group = &(*it->second);
-            auto &image_map = image_group->images;
-            if (auto it2 = image_map.find(hints); it2 != image_map.end()) {
-                auto &data = it2->second;
-                image = data.image;
-                data.count++;
-                goto out_exists;
-            }
-        }
-
-    out_search_hash:
-
-        Log.srtDebug("Session - The session image does not exist. Creating a new one...");
-
-        // Create new one
-        image = new SessionImage();
-        if (std::string error1; !image->open(canonical_path, hints, &error1)) {
-            delete image;
-            return srt::Error{
-                srt::Error::FileNotOpen,
-                "failed to read file: " + error1,
-            };
-        }
+        std::unique_lock<std::shared_mutex> lock(session_system.mtx);
 
-        // Insert
-        if (!image_group) {
+        // Search the image group by path, then by hash
+        SessionSystem::ImageGroup *image_group = nullptr;
+        if (auto it = session_system.path_map.find(canonical_path);
+            it != session_system.path_map.end()) {
+            image_group = &(*it->second);
+        } else if (auto it2 = session_system.hash_size_map.find({size, hash});
+                   it2 != session_system.hash_size_map.end()) {
+            // Another path of an open model, found by path from now on
+            image_group = &(*it2->second);
+            image_group->aliases.push_back(canonical_path);
+            session_system.path_map[canonical_path] = it2->second;
+        } else {
             Log.srtDebug("Session - The session image group doesn't exist. Creating a new group.");
 
             SessionSystem::ImageGroup group;
@@ -734,23 +1437,66 @@ namespace ds::onnxdriver {
             group.size = size;
             group.hash = std::move(hash);
 
-            auto it = session_system.image_list.emplace(session_system.image_list.end(),
-                                                        std::move(group));
-            session_system.path_map[it->path] = it;
-            session_system.hash_size_map[{size, it->hash}] = it;
-            image_group = &(*it);
+            auto it3 = session_system.image_list.emplace(session_system.image_list.end(),
+                                                         std::move(group));
+            session_system.path_map[it3->path] = it3;
+            session_system.hash_size_map[{size, it3->hash}] = it3;
+            image_group = &(*it3);
+        }
+
+        // Search the image, or publish a new one that is being loaded
+        std::shared_future<SessionSystem::LoadResult> future;
+        std::promise<SessionSystem::LoadResult> promise;
+        bool loading = false;
+        if (auto it = image_group->images.find(options); it != image_group->images.end()) {
+            Log.srtDebug(
+                "Session - The session image already exists. Increasing the reference count...");
+            auto &data = it->second;
+            data.count++;
+            future = data.future;
+        } else {
+            Log.srtDebug("Session - The session image does not exist. Creating a new one...");
+            future = promise.get_future().share();
+            image_group->images[options] = {future, 1};
+            loading = true;
         }
-        image_group->images[hints] = {image, 1};
-        goto out_success;
+        const auto &group_hash = image_group->hash;
+        lock.unlock();
 
-    out_exists:
-        Log.srtDebug(
-            "Session - The session image already exists. Increasing the reference count...");
+        // Load the image, other openers of the same image wait for the result. The group
+        // stays alive since this session holds a reference.
+        if (loading) {
+            SessionSystem::LoadResult result;
+            try {
+                auto image = std::make_shared<SessionImage>();
+                if (std::string error1; !image->open(canonical_path, group_hash, options, &error1)) {
+                    result.error = "failed to read file: " + error1;
+                } else {
+                    result.image = std::move(image);
+                }
+            } catch (const std::exception &e) {
+                result.error = std::string("failed to read file: ") + e.what();
+            }
+            promise.set_value(std::move(result));
+        }
 
-    out_success:
+        const auto &result = future.get();
+        if (!result.image) {
+            lock.lock();
+            session_system.release(*image_group, options);
+            return srt::Error{
+                srt::Error::FileNotOpen,
+                result.error,
+            };
+        }
+
+        if (args->reuseOutputBuffers) {
+            impl.outputPool = std::make_shared<OutputBufferPool>();
+        }
+        impl.bucketingPolicy = ShapeBucketingPolicy::fromOpenArgs(*args);
         impl.group = image_group;
-        impl.image = image;
-        impl.hints = hints;
+        impl.image = result.image;
+        impl.options = options;
         impl.realPath = canonical_path;
         return srt::Expected<void>();
     }
@@ -765,39 +1511,25 @@ namespace ds::onnxdriver {
         const auto &filename = path.filename();
         Log.srtDebug("Session [%1] - close", filename);
 
-        auto &session_system = SessionSystem::global();
-        std::unique_lock<std::shared_mutex> lock(session_system.mtx);
-
-        auto &group = *impl.group;
-        auto &images = group.images;
+        // Destroy the image after releasing the lock if this is the last reference
+        auto image = std::move(impl.image);
         {
-            auto it = images.find(impl.hints);
-            assert(it != images.end());
-            auto &data = it->second;
-            if (--data.count != 0) {
-                Log.srtDebug("SessionImage [%1] - ref(), now ref count = %2", filename, data.count);
-                goto out_success;
-            }
-            Log.srtDebug("SessionImage [%1] - delete", filename);
-            delete it->second.image;
-            images.erase(it);
-        }
-        if (images.empty()) {
-            Log.srtDebug("Session - The session image group is empty. Destroying.");
-            auto it = session_system.hash_size_map.find({group.size, group.hash});
-            assert(it != session_system.hash_size_map.end());
-
-            auto list_it = it->second;
+            auto &session_system = SessionSystem::global();
+            std::unique_lock<std::shared_mutex> lock(session_system.mtx);
 
-            session_system.hash_size_map.erase(it);
-            session_system.path_map.erase(group.path);
-            session_system.image_list.erase(list_it);
+            if (auto count = session_system.release(*impl.group, impl.options); count != 0) {
+                Log.srtDebug("SessionImage [%1] - ref(), now ref count = %2", filename, count);
+            } else {
+                Log.srtDebug("SessionImage [%1] - delete", filename);
+            }
         }
+        image.reset();
 
-    out_success:
         impl.group = nullptr;
         impl.image = nullptr;
-        impl.hints = 0;
+        impl.outputPool.reset();
+        impl.bucketingPolicy = {};
+        impl.options = {};
         impl.realPath.clear();
         return srt::Expected<void>();
     }
@@ -833,9 +1565,71 @@ namespace ds::onnxdriver {
         return impl.image->outputNames;
     }
 
+    srt::Expected<srt::NO<Api::Onnx::SessionBindingPlan>>
+        Session::createBindingPlan(const std::vector<std::string> &inputs,
+                                   const std::vector<std::string> &outputs) const {
+        __stdc_impl_t;
+        if (!impl.image) {
+            return srt::Error(srt::Error::SessionError, "session is not open");
+        }
+        const auto &image = *impl.image;
+
+        // Every input of the model must be given exactly once
+        auto plan = srt::NO<CompiledBindingPlan>::create();
+        std::vector<bool> bound(image.inputNames.size(), false);
+        for (const auto &name : inputs) {
+            auto it = std::find(image.inputNames.begin(), image.inputNames.end(), name);
+            if (it == image.inputNames.end()) {
+                return srt::Error(srt::Error::InvalidArgument,
+                                  "unknown input name \"" + name + "\"");
+            }
+            auto index = it - image.inputNames.begin();
+            if (bound[index]) {
+                return srt::Error(srt::Error::InvalidArgument,
+                                  "duplicate input name \"" + name + "\"");
+            }
+            bound[index] = true;
+            plan->inputNames.push_back(it->c_str());
+        }
+        for (size_t i = 0; i < bound.size(); ++i) {
+            if (!bound[i]) {
+                return srt::Error(srt::Error::InvalidArgument,
+                                  "missing input name \"" + image.inputNames[i] + "\"");
+            }
+        }
+
+        std::vector<bool> requested(image.outputNames.size(), false);
+        for (const auto &name : outputs) {
+            auto it = std::find(image.outputNames.begin(), image.outputNames.end(), name);
+            if (it == image.outputNames.end()) {
+                return srt::Error(srt::Error::InvalidArgument,
+                                  "unknown output name \"" + name + "\"");
+            }
+            auto index = it - image.outputNames.begin();
+            if (requested[index]) {
+                return srt::Error(srt::Error::InvalidArgument,
+                                  "duplicate output name \"" + name + "\"");
+            }
+            requested[index] = true;
+            plan->outputNames.push_back(it->c_str());
+        }
+        if (outputs.empty()) {
+            return srt::Error(srt::Error::InvalidArgument, "no output names");
+        }
+
+        plan->image = impl.image;
+        plan->inputs = inputs;
+        plan->outputs = outputs;
+        return plan.as<Api::Onnx::SessionBindingPlan>();
+    }
+
     void Session::terminate() {
         __stdc_impl_t;
-        impl.runOptions.SetTerminate();
+        auto &state = *impl.runState;
+        std::lock_guard<std::mutex> lock(state.mutex);
+        for (auto runOptions : state.activeRuns) {
+            runOptions->SetTerminate();
+        }
     }
 
     srt::Expected<srt::NO<srt::TaskResult>> Session::run(const srt::NO<srt::TaskStartInput> &input) {
@@ -843,21 +1637,21 @@ namespace ds::onnxdriver {
         srt::Error tmpError;
         if (!(input && input->objectName() == Api::Onnx::API_NAME)) {
             tmpError = {srt::Error::InvalidArgument, "invalid task start input"};
-            impl.sessionResult->error = tmpError;
+            impl.runState->setLastError(tmpError);
             return tmpError;
         }
         if (!impl.group) {
             tmpError = {srt::Error::SessionError, "session is not open"};
-            impl.sessionResult->error = tmpError;
+            impl.runState->setLastError(tmpError);
             return tmpError;
         }
         auto startInput = input.as<Api::Onnx::SessionStartInput>();
         auto result = impl.sessionRun(startInput, &tmpError);
         if (!result) {
-            impl.sessionResult->error = tmpError;
+            impl.runState->setLastError(tmpError);
             return tmpError;
         }
-        impl.sessionResult = result;
+        impl.runState->setLastResult(result);
         return result;
     }
 
@@ -867,18 +1661,18 @@ namespace ds::onnxdriver {
         srt::Error tmpError;
         if (!(input && input->objectName() == Api::Onnx::API_NAME)) {
             tmpError = {srt::Error::InvalidArgument, "invalid task start input"};
-            impl.sessionResult->error = tmpError;
+            impl.runState->setLastError(tmpError);
             return tmpError;
         }
         if (!impl.group) {
             tmpError = {srt::Error::SessionError, "session is not open"};
-            impl.sessionResult->error = tmpError;
+            impl.runState->setLastError(tmpError);
             return tmpError;
         }
         auto startInput = input.as<Api::Onnx::SessionStartInput>();
         bool ok = impl.sessionRunAsync(startInput, callback, &tmpError);
         if (!ok) {
-            impl.sessionResult->error = tmpError;
+            impl.runState->setLastError(tmpError);
             return tmpError;
         }
         return srt::Expected<void>();
@@ -886,6 +1680,8 @@ namespace ds::onnxdriver {
 
     srt::NO<srt::TaskResult> Session::result() const {
         __stdc_impl_t;
-        return impl.sessionResult.as<srt::TaskResult>();
+        auto &state = *impl.runState;
+        std::lock_guard<std::mutex> lock(state.mutex);
+        return state.lastResult.as<srt::TaskResult>();
     }
-}
\ No newline at end of file
+}
@@ -1,6 +1,7 @@
 #ifndef DSINFER_ONNXDRIVER_SESSION_H
 #define DSINFER_ONNXDRIVER_SESSION_H
 
+#include <chrono>
 #include <map>
 #include <memory>
 #include <filesystem>
@@ -36,6 +37,14 @@ namespace ds::onnxdriver {
         const std::vector<std::string> &inputNames() const;
         const std::vector<std::string> &outputNames() const;
 
+        // Validates the port names against the model and resolves them to slots, see
+        // Api::Onnx::SessionBindingPlan. The plan is bound to the image of this session.
+        srt::Expected<srt::NO<Api::Onnx::SessionBindingPlan>>
+            createBindingPlan(const std::vector<std::string> &inputs,
+                              const std::vector<std::string> &outputs) const;
+
+        // run(), runAsync() and terminate() are thread-safe, each call has its own run context.
+        // result() returns the result of the latest finished run.
         srt::Expected<srt::NO<srt::TaskResult>> run(const srt::NO<srt::TaskStartInput> &input);
         srt::Expected<void> runAsync(const srt::NO<srt::TaskStartInput> &input, const srt::ITask::StartAsyncCallback &callback);
 
@@ -46,6 +55,16 @@ namespace ds::onnxdriver {
 
         srt::NO<srt::TaskResult> result() const;
 
+        // Dry-run the loaded images of the given models that have not been warmed up yet, in
+        // parallel, or of all open models if none is given. The runs are best-effort, failures
+        // are only logged. Returns the number of images that are warmed up.
+        static int warmUpImages(int64_t length, const std::vector<std::filesystem::path> &models);
+
+        // Shrink the CPU arenas of the loaded images that no run is using, and that have run
+        // since they were last shrunk, but not since idleBefore. With the shared CPU arena, the
+        // run of one image shrinks it for all. Returns the number of images run to shrink them.
+        static int shrinkArenas(std::chrono::steady_clock::time_point idleBefore);
+
     protected:
         class Impl;
         std::unique_ptr<Impl> _impl;
@@ -1,5 +1,9 @@
 #include "SessionImage.h"
 
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
 #include <onnxruntime_cxx_api.h>
 
 #include <dsinfer/Api/Drivers/Onnx/OnnxDriverApi.h>
@@ -7,21 +11,167 @@
 #include "OnnxDriver_Logger.h"
 #include "ExecutionProvider.h"
 #include "Env.h"
+#include "ModelCache.h"
+#include "ImageResidency.h"
 #include "Session.h"
 
+namespace fs = std::filesystem;
+
 namespace ds::onnxdriver {
     using Api::Onnx::ExecutionProvider;
 
+    static inline ::GraphOptimizationLevel
+        getOrtGraphOptimizationLevel(Api::Onnx::GraphOptimizationLevel level) {
+        switch (level) {
+            case Api::Onnx::NoGraphOptimization:
+                return ORT_DISABLE_ALL;
+            case Api::Onnx::BasicGraphOptimization:
+                return ORT_ENABLE_BASIC;
+            case Api::Onnx::ExtendedGraphOptimization:
+                return ORT_ENABLE_EXTENDED;
+            default:
+                return ORT_ENABLE_ALL;
+        }
+    }
+
+    // Sessions with explicit thread counts own their thread pools, the others run on the
+    // global pools of the driver environment if there are any.
+    static bool usesGlobalThreadPools(const SessionImageOptions &options) {
+        bool ownThreadPools = options.intraOpNumThreads > 0 || options.interOpNumThreads > 0 ||
+                              !options.intraOpCores.empty();
+        return !ownThreadPools && Env::useGlobalThreadPools();
+    }
+
+    // The size of the intra-op pool of a session owning its pools, 0 if ORT chooses it.
+    static int ownIntraOpNumThreads(const SessionImageOptions &options) {
+        if (options.intraOpNumThreads == 0 && !options.intraOpCores.empty()) {
+            return static_cast<int>(options.intraOpCores.size());
+        }
+        return options.intraOpNumThreads;
+    }
+
+    // Whether the sessions created with the options have an intra-op thread pool, which
+    // RunAsync() queues the runs to. ORT creates none for a single intra-op thread.
+    static bool hasIntraOpThreadPool(const SessionImageOptions &options) {
+        int numThreads = usesGlobalThreadPools(options) ? Env::globalIntraOpNumThreads()
+                                                        : ownIntraOpNumThreads(options);
+        // ORT chooses a thread per physical core, which are not told apart here
+        return numThreads > 1 || (numThreads == 0 && std::thread::hardware_concurrency() > 1);
+    }
+
+    // The core that the threads calling the sessions created with the options are pinned to,
+    // which is the one left out of their intra-op pool, see Env::intraOpThreadAffinities().
+    static int pinnedCallerCore(const SessionImageOptions &options) {
+        if (usesGlobalThreadPools(options)) {
+            return Env::globalIntraOpCallerCore();
+        }
+        return options.intraOpCores.empty() ? -1 : options.intraOpCores.front();
+    }
+
+    static void applySessionOptions(Ort::SessionOptions &sessOpt,
+                                    const SessionImageOptions &options) {
+        if (usesGlobalThreadPools(options)) {
+            sessOpt.DisablePerSessionThreads();
+        } else {
+            int intraOpNumThreads = ownIntraOpNumThreads(options);
+            sessOpt.SetIntraOpNumThreads(intraOpNumThreads);
+            sessOpt.SetInterOpNumThreads(options.interOpNumThreads);
+            // Pins the intra-op threads, which ORT only supports with an explicit thread count
+            if (auto affinities = Env::intraOpThreadAffinities(options.intraOpCores,
+                                                               intraOpNumThreads);
+                !affinities.empty()) {
+                sessOpt.AddConfigEntry("session.intra_op_thread_affinities", affinities.c_str());
+            }
+            const char *spinning = options.allowSpinning ? "1" : "0";
+            sessOpt.AddConfigEntry("session.intra_op.allow_spinning", spinning);
+            sessOpt.AddConfigEntry("session.inter_op.allow_spinning", spinning);
+        }
+
+        sessOpt.SetGraphOptimizationLevel(
+            getOrtGraphOptimizationLevel(options.graphOptimizationLevel));
+        sessOpt.SetExecutionMode(options.executionMode == Api::Onnx::ParallelExecution
+                                     ? ORT_PARALLEL
+                                     : ORT_SEQUENTIAL);
+        if (options.enableMemPattern) {
+            sessOpt.EnableMemPattern();
+        } else {
+            sessOpt.DisableMemPattern();
+        }
+        if (Env::useSharedCpuAllocator()) {
+            sessOpt.AddConfigEntry("session.use_env_allocators", "1");
+        }
+    }
+
+    static inline bool runsOnCpu(const SessionImageOptions &options) {
+        return (options.hints & Session::SH_PreferCPUHint) ||
+               Env::getDeviceConfig().ep == ExecutionProvider::CPUExecutionProvider;
+    }
+
+    // The options of one of the sessions of an image. The pinned cores are split into a slice
+    // per replica, so that the replicas running at once do not compete for them. With fewer
+    // cores than replicas, each replica is pinned to one core in turn.
+    static SessionImageOptions replicaOptions(const SessionImageOptions &options, int index) {
+        auto result = options;
+        const auto &cores = options.intraOpCores;
+        const auto numCores = static_cast<int>(cores.size());
+        if (options.replicas <= 1 || numCores == 0) {
+            return result;
+        }
+        if (numCores < options.replicas) {
+            result.intraOpCores = {cores[index % numCores]};
+        } else {
+            result.intraOpCores.assign(cores.begin() + index * numCores / options.replicas,
+                                       cores.begin() +
+                                           (index + 1) * numCores / options.replicas);
+        }
+        return result;
+    }
+
+
+    // prepackedWeights: if not null, the container to share the prepacked weights in
+    // modelPath: the ONNX model, or an ORT format model if loadOrtFormat is set
+    // mapping: if not null, the mapped content of modelPath to create the session from
+    // optimizedModelPath: if not empty, save the optimized model in ORT format to this path
+    // profilePrefix: if not empty, profile the session and write the trace with this prefix
     static Ort::Session createOrtSession(const Ort::Env &ortEnv,
+                                         Ort::PrepackedWeightsContainer *prepackedWeights,
                                          const std::filesystem::path &modelPath,
-                                         bool preferCpu,
+                                         const MappedFile *mapping,
+                                         const SessionImageOptions &options,
+                                         bool loadOrtFormat,
+                                         const std::filesystem::path &optimizedModelPath,
+                                         const std::filesystem::path &profilePrefix,
                                          std::string *errorMessage) {
         auto devConfig = Env::getDeviceConfig();
         auto ep = devConfig.ep;
         auto deviceIndex = devConfig.deviceIndex;
+        bool preferCpu = options.hints & Session::SH_PreferCPUHint;
         try {
             Ort::SessionOptions sessOpt;
 
+            // Must be applied before the execution provider, which may override some of them
+            applySessionOptions(sessOpt, options);
+
+            if (loadOrtFormat) {
+                // The model has been optimized when it was saved
+                sessOpt.AddConfigEntry("session.load_model_format", "ORT");
+                sessOpt.SetGraphOptimizationLevel(ORT_DISABLE_ALL);
+                if (mapping) {
+                    // Refer to the mapped bytes instead of copying them, so the processes
+                    // loading the same model share the pages of its initializers
+                    sessOpt.AddConfigEntry("session.use_ort_model_bytes_directly", "1");
+                    sessOpt.AddConfigEntry("session.use_ort_model_bytes_for_initializers", "1");
+                }
+            }
+            if (!optimizedModelPath.empty()) {
+                sessOpt.AddConfigEntry("session.save_model_format", "ORT");
+                sessOpt.SetOptimizedModelFilePath(
+                    std::filesystem::path::string_type(optimizedModelPath).c_str());
+            }
+            if (!profilePrefix.empty()) {
+                sessOpt.EnableProfiling(std::filesystem::path::string_type(profilePrefix).c_str());
+            }
+
             std::string initEPErrorMsg;
             if (!preferCpu) {
                 switch (ep) {
@@ -58,8 +208,18 @@ namespace ds::onnxdriver {
             } else {
                 Log.srtInfo("The model prefers to use CPU. [%1]", modelPath.filename());
             }
-            return Ort::Session{ortEnv, std::filesystem::path::string_type(modelPath).c_str(),
-                                sessOpt};
+            if (mapping) {
+                if (prepackedWeights) {
+                    return Ort::Session{ortEnv, mapping->data(), mapping->size(), sessOpt,
+                                        *prepackedWeights};
+                }
+                return Ort::Session{ortEnv, mapping->data(), mapping->size(), sessOpt};
+            }
+            auto modelPathString = std::filesystem::path::string_type(modelPath);
+            if (prepackedWeights) {
+                return Ort::Session{ortEnv, modelPathString.c_str(), sessOpt, *prepackedWeights};
+            }
+            return Ort::Session{ortEnv, modelPathString.c_str(), sessOpt};
         } catch (const Ort::Exception &e) {
             if (errorMessage) {
                 *errorMessage = e.what();
@@ -68,58 +228,476 @@ namespace ds::onnxdriver {
         return Ort::Session{nullptr};
     }
 
-    static void loggingFuncOrt(void *param, OrtLoggingLevel severity, const char *category,
-                               const char *logid, const char *code_location, const char *message) {
-        switch (severity) {
-            case ORT_LOGGING_LEVEL_VERBOSE:
-                Log.srtLog(Debug, "[%1] %2", code_location, message);
-                break;
-            case ORT_LOGGING_LEVEL_WARNING:
-                Log.srtLog(Warning, "[%1] %2", code_location, message);
-                break;
-            case ORT_LOGGING_LEVEL_ERROR:
-                Log.srtLog(Critical, "[%1] %2", code_location, message);
-                break;
-            case ORT_LOGGING_LEVEL_FATAL:
-                Log.srtLog(Fatal, "[%1] %2", code_location, message);
-                break;
+    static SessionImage::PortInfo getPortInfo(const Ort::TypeInfo &typeInfo) {
+        SessionImage::PortInfo info;
+        if (typeInfo.GetONNXType() != ONNX_TYPE_TENSOR) {
+            return info;
+        }
+        auto tensorInfo = typeInfo.GetTensorTypeAndShapeInfo();
+        info.type = tensorInfo.GetElementType();
+        info.shape = tensorInfo.GetShape();
+        auto symbols = tensorInfo.GetSymbolicDimensions();
+        info.symbolicShape.reserve(symbols.size());
+        for (const auto symbol : symbols) {
+            info.symbolicShape.emplace_back(symbol ? symbol : "");
+        }
+        return info;
+    }
+
+    // Everything is filled with zeros, which are in range for the index and ID inputs, such as
+    // the tokens and the speaker and language IDs.
+    static bool fillSyntheticTensor(Ort::Value &value, size_t count,
+                                    ONNXTensorElementDataType type) {
+        auto data = value.GetTensorMutableRawData();
+        switch (type) {
+            case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+                std::fill_n(static_cast<int64_t *>(data), count, 0);
+                return true;
+            case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+                std::fill_n(static_cast<int32_t *>(data), count, 0);
+                return true;
+            case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+                std::fill_n(static_cast<float *>(data), count, 0.0f);
+                return true;
+            case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+                std::fill_n(static_cast<double *>(data), count, 0.0);
+                return true;
+            case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+            case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+            case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+                std::fill_n(static_cast<uint8_t *>(data), count, 0);
+                return true;
+            case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+            case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+                std::fill_n(static_cast<uint16_t *>(data), count, 0);
+                return true;
             default:
-                Log.srtLog(Information, "[%1] %2", code_location, message);
-                break;
+                return false;
         }
     }
 
     SessionImage::SessionImage()
-        : env(ORT_LOGGING_LEVEL_WARNING, "dsinfer", loggingFuncOrt, nullptr), session(nullptr) {
+        : session(nullptr) {
+    }
+
+    SessionImage::~SessionImage() {
+        ImageResidency::remove(this);
+        std::vector<ProfilingTrace> traces;
+        endProfiling(traces);
+        passProfilingTraces(traces);
     }
 
-    SessionImage::~SessionImage() = default;
+    SessionImageOptions SessionImageOptions::fromOpenArgs(const Api::Onnx::SessionOpenArgs &args) {
+        SessionImageOptions options;
+        if (args.useCpu) {
+            options.hints |= Session::SH_PreferCPUHint;
+        }
+        options.intraOpNumThreads = std::max(args.intraOpNumThreads, 0);
+        options.interOpNumThreads = std::max(args.interOpNumThreads, 0);
+        for (const auto core : args.intraOpCores) {
+            if (core >= 0) {
+                options.intraOpCores.push_back(core);
+            }
+        }
+        options.graphOptimizationLevel = args.graphOptimizationLevel;
+        options.executionMode = args.executionMode;
+        options.enableMemPattern = args.enableMemPattern;
+        options.allowSpinning = args.allowSpinning;
+        options.memoryMapModel = args.memoryMapModel;
+        options.enableProfiling = args.enableProfiling;
+        options.replicas = std::max(args.replicas, 1);
+        return options;
+    }
 
-    bool SessionImage::open(const std::filesystem::path &onnxPath, int hints,
-                            std::string *errorMessage) {
+    bool SessionImage::load(std::string *errorMessage) {
+        const auto &onnxPath = _path;
+        const auto &options = _options;
         auto filename = onnxPath.filename();
-        Log.srtDebug("SessionImage [%1] - creating", filename);
 
-        session = createOrtSession(env, onnxPath, hints & Session::SH_PreferCPUHint, errorMessage);
+        // Held until the sessions are released, the driver may release them before
+        _ortEnv = Env::ortEnv();
+        _prepackedWeights = Env::prepackedWeightsContainer();
+        if (!_ortEnv) {
+            _prepackedWeights.reset();
+            if (errorMessage) {
+                *errorMessage = "onnx environment is not initialized";
+            }
+            return false;
+        }
+        const auto &env = _ortEnv;
+        const auto prepackedWeights = _prepackedWeights.get();
+        const auto primaryOptions = replicaOptions(options, 0);
+
+        // ORT appends the start time to the prefix, the id tells apart the images of the same
+        // model loaded at once
+        std::filesystem::path profilePrefix;
+        if (options.enableProfiling) {
+            auto name = onnxPath.stem().string() + "_" + std::to_string(Env::nextId());
+            profilePrefix = Env::getProfilingConfig().directory / name;
+        }
+
+        // Optimized models are only cached for the CPU provider, the graphs optimized for other
+        // providers may depend on the device state at the time they were saved.
+        std::filesystem::path cacheEntryPath;
+        if (runsOnCpu(options)) {
+            cacheEntryPath =
+                ModelCache::entryPath(_modelHash, options, Api::Onnx::CPUExecutionProvider);
+        }
+
+        if (std::error_code ec; !cacheEntryPath.empty() && fs::exists(cacheEntryPath, ec)) {
+            Log.srtDebug("SessionImage [%1] - loading optimized model %2", filename,
+                         cacheEntryPath);
+            std::string cacheErrorMessage;
+            MappedFile mapping;
+            if (options.memoryMapModel && !mapping.open(cacheEntryPath, &cacheErrorMessage)) {
+                Log.srtWarning("SessionImage [%1] - failed to map optimized model: %2", filename,
+                               cacheErrorMessage);
+            }
+            session = createOrtSession(*env, prepackedWeights, cacheEntryPath,
+                                       mapping.isOpen() ? &mapping : nullptr, primaryOptions,
+                                       true, {}, profilePrefix, &cacheErrorMessage);
+            if (session && mapping.isOpen()) {
+                modelMapping = std::move(mapping);
+            }
+            if (!session) {
+                Log.srtWarning("SessionImage [%1] - removing broken cache entry: %2", filename,
+                               cacheErrorMessage);
+                ModelCache::remove(cacheEntryPath);
+            }
+        }
+
         if (!session) {
+            std::filesystem::path temporaryPath;
+            if (!cacheEntryPath.empty()) {
+                temporaryPath = ModelCache::temporaryPath(cacheEntryPath);
+            }
+            if (options.memoryMapModel) {
+                // ORT parses the ONNX model into its own memory, so the mapping is only needed
+                // while creating the session
+                std::string mappedErrorMessage;
+                MappedFile mapping;
+                if (!mapping.open(onnxPath, &mappedErrorMessage)) {
+                    Log.srtWarning("SessionImage [%1] - failed to map model: %2", filename,
+                                   mappedErrorMessage);
+                } else {
+                    session = createOrtSession(*env, prepackedWeights, onnxPath, &mapping,
+                                               primaryOptions, false, temporaryPath, profilePrefix,
+                                               &mappedErrorMessage);
+                    if (!session) {
+                        // The external data of a model loaded from memory cannot be located
+                        Log.srtDebug("SessionImage [%1] - failed to create from mapped model, "
+                                     "loading from file: %2",
+                                     filename, mappedErrorMessage);
+                    }
+                }
+            }
+            if (!session) {
+                session = createOrtSession(*env, prepackedWeights, onnxPath, nullptr,
+                                           primaryOptions, false, temporaryPath, profilePrefix,
+                                           errorMessage);
+            }
+            if (!temporaryPath.empty()) {
+                if (session) {
+                    ModelCache::commit(temporaryPath, cacheEntryPath);
+                } else {
+                    ModelCache::remove(temporaryPath);
+                }
+            }
+        }
+        if (!session) {
+            releaseEnv();
+            return false;
+        }
+
+        // The replicas are created from the optimized model if it has been cached, so that
+        // they skip the graph optimization, and share the mapping of the primary session
+        replicas.clear();
+        if (options.replicas > 1) {
+            std::filesystem::path replicaPath = onnxPath;
+            bool loadOrtFormat = false;
+            if (std::error_code ec; !cacheEntryPath.empty() && fs::exists(cacheEntryPath, ec)) {
+                replicaPath = cacheEntryPath;
+                loadOrtFormat = true;
+            }
+            const MappedFile *mapping =
+                loadOrtFormat && modelMapping.isOpen() ? &modelMapping : nullptr;
+            replicas.reserve(options.replicas - 1);
+            for (int i = 1; i < options.replicas; ++i) {
+                auto replicaPrefix = profilePrefix;
+                if (!replicaPrefix.empty()) {
+                    replicaPrefix += "_r" + std::to_string(i);
+                }
+                auto replica = createOrtSession(*env, prepackedWeights, replicaPath, mapping,
+                                                replicaOptions(options, i), loadOrtFormat, {},
+                                                replicaPrefix, errorMessage);
+                if (!replica) {
+                    // Leave the image as unloaded, the mapping is only used by the sessions
+                    replicas.clear();
+                    session = Ort::Session(nullptr);
+                    modelMapping.close();
+                    releaseEnv();
+                    return false;
+                }
+                replicas.push_back(std::move(replica));
+            }
+            Log.srtDebug("SessionImage [%1] - created %2 replica(s)", filename, options.replicas);
+        }
+        _replicaRuns.assign(options.replicas, 0);
+        return true;
+    }
+
+    bool SessionImage::open(const std::filesystem::path &onnxPath,
+                            const std::vector<uint8_t> &modelHash,
+                            const SessionImageOptions &options, std::string *errorMessage) {
+        auto filename = onnxPath.filename();
+        Log.srtDebug("SessionImage [%1] - creating", filename);
+
+        _path = onnxPath;
+        _modelHash = modelHash;
+        _options = options;
+        canRunAsync = true;
+        _callerCores.clear();
+        for (int i = 0; i < options.replicas; ++i) {
+            auto sessionOptions = replicaOptions(options, i);
+            canRunAsync = canRunAsync && hasIntraOpThreadPool(sessionOptions);
+            _callerCores.push_back(pinnedCallerCore(sessionOptions));
+        }
+        if (std::error_code ec; (residentSize = fs::file_size(onnxPath, ec)), ec) {
+            residentSize = 0;
+        }
+        residentSize *= options.replicas;
+
+        if (!load(errorMessage)) {
             Log.srtCritical("SessionImage [%1] - create failed", filename);
             return false;
         }
+        _lastUsed = std::chrono::steady_clock::now();
         Ort::AllocatorWithDefaultOptions allocator;
 
         auto inputCount = session.GetInputCount();
         inputNames.reserve(inputCount);
+        inputInfos.reserve(inputCount);
         for (size_t i = 0; i < inputCount; ++i) {
             inputNames.emplace_back(session.GetInputNameAllocated(i, allocator).get());
+            inputInfos.push_back(getPortInfo(session.GetInputTypeInfo(i)));
         }
 
         auto outputCount = session.GetOutputCount();
         outputNames.reserve(outputCount);
+        outputInfos.reserve(outputCount);
         for (size_t i = 0; i < outputCount; ++i) {
             outputNames.emplace_back(session.GetOutputNameAllocated(i, allocator).get());
+            outputInfos.push_back(getPortInfo(session.GetOutputTypeInfo(i)));
         }
         Log.srtDebug("SessionImage [%1] - created successfully", filename);
+
+        ImageResidency::add(this, false);
         return true;
     }
 
-}
\ No newline at end of file
+    Ort::Session *SessionImage::acquire(std::string *errorMessage) {
+        bool reloaded = false;
+        Ort::Session *replica;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!session) {
+                Log.srtDebug("SessionImage [%1] - reloading", _path.filename());
+                if (!load(errorMessage)) {
+                    Log.srtCritical("SessionImage [%1] - reload failed", _path.filename());
+                    return nullptr;
+                }
+                reloaded = true;
+            }
+            ++_activeRuns;
+            _lastUsed = std::chrono::steady_clock::now();
+
+            // An idle replica if there is one, otherwise the least busy one
+            auto it = std::min_element(_replicaRuns.begin(), _replicaRuns.end());
+            auto index = it - _replicaRuns.begin();
+            ++*it;
+            replica = index == 0 ? &session : &replicas[index - 1];
+        }
+        if (reloaded) {
+            ImageResidency::add(this, true);
+        } else {
+            ImageResidency::touch(this);
+        }
+        return replica;
+    }
+
+    void SessionImage::release(Ort::Session *replica) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        --_activeRuns;
+        _lastUsed = std::chrono::steady_clock::now();
+        auto index = replica == &session ? 0 : replica - replicas.data() + 1;
+        --_replicaRuns[index];
+    }
+
+    int SessionImage::callerCore(const Ort::Session *replica) const {
+        auto index = replica == &session ? 0 : replica - replicas.data() + 1;
+        return _callerCores[index];
+    }
+
+    bool SessionImage::tryUnload(std::vector<ProfilingTrace> &traces,
+                                 std::chrono::steady_clock::time_point idleBefore) {
+        std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
+        if (!lock.owns_lock() || _activeRuns > 0 || !session || _lastUsed >= idleBefore) {
+            return false;
+        }
+        Log.srtDebug("SessionImage [%1] - unloading", _path.filename());
+        endProfiling(traces);
+        replicas.clear();
+        session = Ort::Session(nullptr);
+        modelMapping.close();
+        releaseEnv();
+        // The sessions loaded again have not run yet
+        _warmedUp = false;
+        return true;
+    }
+
+    void SessionImage::releaseEnv() {
+        _prepackedWeights.reset();
+        _ortEnv.reset();
+    }
+
+    void SessionImage::endProfiling(std::vector<ProfilingTrace> &traces) {
+        if (!_options.enableProfiling || !session) {
+            return;
+        }
+        for (size_t i = 0; i <= replicas.size(); ++i) {
+            auto &replica = i == 0 ? session : replicas[i - 1];
+            std::filesystem::path tracePath;
+            try {
+                Ort::AllocatorWithDefaultOptions allocator;
+                tracePath = replica.EndProfilingAllocated(allocator).get();
+            } catch (const Ort::Exception &e) {
+                Log.srtWarning("SessionImage [%1] - failed to end profiling: %2",
+                               _path.filename(), e.what());
+                continue;
+            }
+            Log.srtInfo("SessionImage [%1] - profiling trace written to %2", _path.filename(),
+                        tracePath);
+            traces.push_back({_path, std::move(tracePath)});
+        }
+    }
+
+    void SessionImage::passProfilingTraces(const std::vector<ProfilingTrace> &traces) {
+        if (traces.empty()) {
+            return;
+        }
+        auto sink = Env::getProfilingConfig().sink;
+        if (!sink) {
+            return;
+        }
+        for (const auto &trace : traces) {
+            sink(trace.modelPath, trace.tracePath);
+        }
+    }
+
+    void SessionImage::runSynthetic(int64_t length, const Ort::RunOptions &runOptions) {
+        Ort::AllocatorWithDefaultOptions allocator;
+        std::vector<const char *> inputNamePtrs;
+        std::vector<Ort::Value> inputValues;
+        inputNamePtrs.reserve(inputNames.size());
+        inputValues.reserve(inputNames.size());
+        for (size_t i = 0; i < inputNames.size(); ++i) {
+            const auto &info = inputInfos[i];
+            auto shape = info.shape;
+            size_t count = 1;
+            for (size_t axis = 0; axis < shape.size(); ++axis) {
+                if (shape[axis] < 0) {
+                    shape[axis] = (axis == 0 && shape.size() > 1) ? 1 : length;
+                }
+                count *= static_cast<size_t>(shape[axis]);
+            }
+            auto value =
+                Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), info.type);
+            if (!fillSyntheticTensor(value, count, info.type)) {
+                throw std::runtime_error("unsupported type of input \"" + inputNames[i] + "\"");
+            }
+            inputNamePtrs.push_back(inputNames[i].c_str());
+            inputValues.push_back(std::move(value));
+        }
+
+        std::vector<const char *> outputNamePtrs;
+        outputNamePtrs.reserve(outputNames.size());
+        for (const auto &name : outputNames) {
+            outputNamePtrs.push_back(name.c_str());
+        }
+
+        // Every replica has its own kernels and arena
+        for (size_t i = 0; i <= replicas.size(); ++i) {
+            auto &replica = i == 0 ? session : replicas[i - 1];
+            replica.Run(runOptions, inputNamePtrs.data(), inputValues.data(), inputValues.size(),
+                        outputNamePtrs.data(), outputNamePtrs.size());
+        }
+    }
+
+    bool SessionImage::warmUp(int64_t length, std::string *errorMessage) {
+        // Concurrent warm-ups of the same image may both run, which is harmless
+        if (_warmedUp) {
+            return true;
+        }
+        auto acquired = acquire(errorMessage);
+        if (!acquired) {
+            return false;
+        }
+
+        bool ok = false;
+        try {
+            runSynthetic(length, Ort::RunOptions());
+            ok = true;
+            _warmedUp = true;
+        } catch (const std::exception &e) {
+            if (errorMessage) {
+                *errorMessage = e.what();
+            }
+        }
+        release(acquired);
+        return ok;
+    }
+
+    bool SessionImage::canShrinkArenas(std::chrono::steady_clock::time_point idleBefore) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return session && _activeRuns == 0 && _lastShrunk < _lastUsed && _lastUsed < idleBefore;
+    }
+
+    bool SessionImage::shrinkArenas(std::string *errorMessage) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!session) {
+                if (errorMessage) {
+                    *errorMessage = "session is not loaded";
+                }
+                return false;
+            }
+            // Keeps the sessions loaded like a run, but the time of the last run is left alone
+            ++_activeRuns;
+            _lastShrunk = _lastUsed;
+        }
+
+        bool ok = false;
+        try {
+            // The arena is shrunk at the end of the run, the smallest inputs leave the least of
+            // it in use by then
+            Ort::RunOptions runOptions;
+            runOptions.AddConfigEntry("memory.enable_memory_arena_shrinkage", "cpu:0");
+            runSynthetic(1, runOptions);
+            ok = true;
+        } catch (const std::exception &e) {
+            if (errorMessage) {
+                *errorMessage = e.what();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        --_activeRuns;
+        return ok;
+    }
+
+    void SessionImage::setArenasShrunk() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _lastShrunk = _lastUsed;
+    }
+
+}
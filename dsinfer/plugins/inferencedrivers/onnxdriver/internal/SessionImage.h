@@ -1,28 +1,173 @@
 #ifndef DSINFER_ONNXDRIVER_SESSIONIMAGE_P_H
 #define DSINFER_ONNXDRIVER_SESSIONIMAGE_P_H
 
+#include <atomic>
+#include <chrono>
 #include <filesystem>
+#include <memory>
+#include <mutex>
+#include <tuple>
 
 #include <synthrt/Support/Expected.h>
+#include <dsinfer/Api/Drivers/Onnx/OnnxDriverApi.h>
 
 #include <onnxruntime_cxx_api.h>
 
+#include "MappedFile.h"
+
 namespace ds::onnxdriver {
 
+    // Everything that affects how an ORT session is created from a model. Sessions opened with
+    // equal options share the same image.
+    struct SessionImageOptions {
+        int hints = 0;
+        int intraOpNumThreads = 0;
+        int interOpNumThreads = 0;
+        std::vector<int> intraOpCores;
+        Api::Onnx::GraphOptimizationLevel graphOptimizationLevel =
+            Api::Onnx::AllGraphOptimization;
+        Api::Onnx::ExecutionMode executionMode = Api::Onnx::SequentialExecution;
+        bool enableMemPattern = true;
+        bool allowSpinning = true;
+        bool memoryMapModel = false;
+        bool enableProfiling = false;
+        int replicas = 1;
+
+        static SessionImageOptions fromOpenArgs(const Api::Onnx::SessionOpenArgs &args);
+
+        inline auto tie() const {
+            return std::tie(hints, intraOpNumThreads, interOpNumThreads, intraOpCores,
+                            graphOptimizationLevel, executionMode, enableMemPattern,
+                            allowSpinning, memoryMapModel, enableProfiling, replicas);
+        }
+
+        inline bool operator<(const SessionImageOptions &other) const {
+            return tie() < other.tie();
+        }
+
+        inline bool operator==(const SessionImageOptions &other) const {
+            return tie() == other.tie();
+        }
+    };
+
+    // A profiling trace written when a session image was unloaded, to be passed to the sink
+    // once no lock is held.
+    struct ProfilingTrace {
+        std::filesystem::path modelPath;
+        std::filesystem::path tracePath;
+    };
+
     class SessionImage {
     public:
         SessionImage();
         ~SessionImage();
 
-        bool open(const std::filesystem::path &onnxPath, int hints,
-                  std::string *errorMessage = nullptr);
+        bool open(const std::filesystem::path &onnxPath, const std::vector<uint8_t> &modelHash,
+                  const SessionImageOptions &options, std::string *errorMessage = nullptr);
+
+        // Keep the session loaded for a run, reloading it if it has been unloaded. Returns the
+        // replica with the fewest runs to run on, or null if failed.
+        Ort::Session *acquire(std::string *errorMessage = nullptr);
+        void release(Ort::Session *replica);
+
+        // The core to pin the thread running the replica to for the run, as ORT only pins the
+        // threads of the pools. Negative if the replica is not pinned.
+        int callerCore(const Ort::Session *replica) const;
+
+        // Unload the session to free its memory if no run is using it, and if the last run
+        // finished before idleBefore. The port information is kept, so the image stays usable.
+        // The profiling traces written are appended to traces, the caller passes them to the
+        // sink with passProfilingTraces() after releasing its locks.
+        bool tryUnload(std::vector<ProfilingTrace> &traces,
+                       std::chrono::steady_clock::time_point idleBefore =
+                           std::chrono::steady_clock::time_point::max());
+
+        // Call the profiling sink of the driver with each trace. Must not be called with any
+        // lock held, the sink may open or run sessions.
+        static void passProfilingTraces(const std::vector<ProfilingTrace> &traces);
+
+        // Run the session once with synthetic inputs, so that the kernels and the memory arena
+        // are initialized before the first real run. Dynamic dimensions are set to the given
+        // length, except a leading batch dimension. Does nothing if already warmed up since the
+        // image was last loaded, a failed warm-up is tried again by the next call.
+        bool warmUp(int64_t length, std::string *errorMessage = nullptr);
+
+        // Whether the image is loaded and no run is using it, and it has run since its arenas
+        // were last shrunk, but not since idleBefore.
+        bool canShrinkArenas(std::chrono::steady_clock::time_point idleBefore);
+
+        // Run every session once with the smallest synthetic inputs, asking ORT to shrink the
+        // CPU arena at the end of the run, which gives the memory that no run uses back to the
+        // system. The runs do not count as uses of the image. Fails if it is not loaded.
+        bool shrinkArenas(std::string *errorMessage = nullptr);
+
+        // Record the arenas as shrunk without running, when they are shared with an image that
+        // has been shrunk.
+        void setArenasShrunk();
 
     public:
+        // Type and shape of a model input or output. Dynamic dimensions are negative, with
+        // their symbolic names if the model declares any.
+        struct PortInfo {
+            ONNXTensorElementDataType type = ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED;
+            std::vector<int64_t> shape;
+            std::vector<std::string> symbolicShape;
+        };
+
         std::vector<std::string> inputNames;
         std::vector<std::string> outputNames;
 
-        Ort::Env env;
+        // In the same order as the names
+        std::vector<PortInfo> inputInfos;
+        std::vector<PortInfo> outputInfos;
+
+        // The mapped model that the session refers to, must outlive the session
+        MappedFile modelMapping;
+
+    protected:
+        // The environment and the prepacked weights the sessions were created with. Declared
+        // before the sessions, so that they are destroyed after them.
+        std::shared_ptr<Ort::Env> _ortEnv;
+        std::shared_ptr<Ort::PrepackedWeightsContainer> _prepackedWeights;
+
+    public:
+
+        // The primary session, and the other replicas of it that runs are dispatched to
         Ort::Session session;
+        std::vector<Ort::Session> replicas;
+
+        // Estimated memory usage of the loaded session
+        uintmax_t residentSize = 0;
+
+        // Whether the sessions can start runs with RunAsync(), which needs an intra-op thread
+        // pool to run on. The async runs of the others are started on a thread of their own.
+        bool canRunAsync = true;
+
+    protected:
+        bool load(std::string *errorMessage);
+
+        // Run every session once with synthetic inputs, see warmUp(). Throws if failed.
+        void runSynthetic(int64_t length, const Ort::RunOptions &runOptions);
+
+        // Drop the references to the environment once the sessions are released.
+        void releaseEnv();
+
+        // Write the profiling traces of the loaded session and its replicas before they are
+        // released, and append them to traces. Does nothing if profiling is disabled.
+        void endProfiling(std::vector<ProfilingTrace> &traces);
+
+        std::filesystem::path _path;
+        std::vector<uint8_t> _modelHash;
+        SessionImageOptions _options;
+
+        std::mutex _mutex;
+        int _activeRuns = 0;
+        std::vector<int> _replicaRuns; // active runs of each replica, primary first
+        std::vector<int> _callerCores; // see callerCore(), primary first
+        std::chrono::steady_clock::time_point _lastUsed;
+        std::chrono::steady_clock::time_point _lastShrunk; // _lastUsed when last shrunk
+
+        std::atomic<bool> _warmedUp = false;
     };
 
 }
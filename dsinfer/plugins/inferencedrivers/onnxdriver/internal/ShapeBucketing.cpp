@@ -0,0 +1,275 @@
+#include "ShapeBucketing.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "SessionImage.h"
+
+namespace ds::onnxdriver {
+
+    // Copies a tensor into a buffer of another shape. Axes that shrink are cut, axes that grow
+    // repeat the last element of the source along that axis. An empty source has no element to
+    // repeat, so the destination is zero-filled.
+    static void copyResized(const std::byte *src, const std::vector<int64_t> &srcShape,
+                            std::byte *dst, const std::vector<int64_t> &dstShape,
+                            size_t elementSize) {
+        const size_t rank = dstShape.size();
+        if (rank == 0) {
+            std::memcpy(dst, src, elementSize);
+            return;
+        }
+        if (std::any_of(srcShape.begin(), srcShape.end(), [](int64_t dim) { return dim <= 0; })) {
+            size_t dstCount = 1;
+            for (const auto dim : dstShape) {
+                dstCount *= static_cast<size_t>(dim);
+            }
+            std::memset(dst, 0, dstCount * elementSize);
+            return;
+        }
+
+        // Strides in elements
+        std::vector<size_t> srcStrides(rank, 1);
+        for (size_t i = rank - 1; i > 0; --i) {
+            srcStrides[i - 1] = srcStrides[i] * static_cast<size_t>(srcShape[i]);
+        }
+
+        const auto srcRow = static_cast<size_t>(srcShape[rank - 1]);
+        const auto dstRow = static_cast<size_t>(dstShape[rank - 1]);
+        const auto copyCount = std::min(srcRow, dstRow);
+
+        size_t outerCount = 1;
+        for (size_t i = 0; i + 1 < rank; ++i) {
+            outerCount *= static_cast<size_t>(dstShape[i]);
+        }
+
+        std::vector<int64_t> index(rank, 0);
+        for (size_t row = 0; row < outerCount; ++row) {
+            size_t srcOffset = 0;
+            for (size_t i = 0; i + 1 < rank; ++i) {
+                srcOffset += static_cast<size_t>(std::min(index[i], srcShape[i] - 1)) * srcStrides[i];
+            }
+
+            auto srcPtr = src + srcOffset * elementSize;
+            std::memcpy(dst, srcPtr, copyCount * elementSize);
+            for (size_t j = copyCount; j < dstRow; ++j) {
+                std::memcpy(dst + j * elementSize, srcPtr + (srcRow - 1) * elementSize,
+                            elementSize);
+            }
+            dst += dstRow * elementSize;
+
+            // Next outer index
+            for (size_t i = rank - 1; i > 0; --i) {
+                if (++index[i - 1] < dstShape[i - 1]) {
+                    break;
+                }
+                index[i - 1] = 0;
+            }
+        }
+    }
+
+    static srt::Expected<srt::NO<ITensor>> resizeTensor(const srt::NO<ITensor> &tensor,
+                                                        const std::vector<int64_t> &shape) {
+        auto exp = Tensor::create(tensor->dataType(), shape);
+        if (!exp) {
+            return exp.takeError();
+        }
+        auto result = exp.take();
+        // Strided views are gathered first, the copy below walks contiguous rows
+        auto source = tensor->isContiguous() ? tensor : tensor->clone();
+        if (!source) {
+            return srt::Error(srt::Error::InvalidArgument, "failed to gather tensor view");
+        }
+        copyResized(source->rawData(), source->shape(), result->mutableRawData(), shape,
+                    source->elementSize());
+        return result;
+    }
+
+    ShapeBucketingPolicy ShapeBucketingPolicy::fromOpenArgs(const Api::Onnx::SessionOpenArgs &args) {
+        ShapeBucketingPolicy policy;
+        policy.mode = args.shapeBucketing;
+        policy.bucketSize = args.bucketSize;
+        policy.dimensions = args.bucketedDimensions;
+        return policy;
+    }
+
+    int64_t ShapeBucketingPolicy::bucket(int64_t size) const {
+        if (size <= 0) {
+            return size;
+        }
+        switch (mode) {
+            case Api::Onnx::MultipleOfBucketing:
+                return (size + bucketSize - 1) / bucketSize * bucketSize;
+            case Api::Onnx::PowerOfTwoBucketing: {
+                int64_t result = 1;
+                while (result < size) {
+                    result <<= 1;
+                }
+                return std::max(result, bucketSize);
+            }
+            default:
+                return size;
+        }
+    }
+
+    srt::Expected<srt::NO<Api::Onnx::SessionStartInput>>
+        padInputs(const ShapeBucketingPolicy &policy, const SessionImage &image,
+                  const srt::NO<Api::Onnx::SessionStartInput> &input,
+                  BucketedDimensions &dimensions) {
+        dimensions.clear();
+
+        // The tensor of an input of the model, by name or by the slot of the binding plan
+        auto findInput = [](Api::Onnx::SessionStartInput &input,
+                            const std::string &name) -> srt::NO<ITensor> * {
+            if (const auto &plan = input.bindingPlan) {
+                auto it = std::find(plan->inputs.begin(), plan->inputs.end(), name);
+                if (it == plan->inputs.end()) {
+                    return nullptr;
+                }
+                return &input.inputSlots[it - plan->inputs.begin()];
+            }
+            auto it = input.inputs.find(name);
+            return it != input.inputs.end() ? &it->second : nullptr;
+        };
+
+        // Collect the sizes of the bucketed dimensions. The inputs sharing a dimension must
+        // agree on its size, otherwise the dimension is left alone.
+        std::set<std::string> conflicts;
+        for (size_t i = 0; i < image.inputNames.size(); ++i) {
+            auto tensor = findInput(*input, image.inputNames[i]);
+            if (!tensor) {
+                continue;
+            }
+            const auto &symbols = image.inputInfos[i].symbolicShape;
+            auto shape = (*tensor)->shape();
+            for (size_t axis = 0; axis < symbols.size() && axis < shape.size(); ++axis) {
+                const auto &symbol = symbols[axis];
+                if (policy.dimensions.count(symbol) == 0) {
+                    continue;
+                }
+                auto [it2, inserted] = dimensions.try_emplace(symbol, BucketedDimension{
+                                                                          shape[axis],
+                                                                          policy.bucket(shape[axis]),
+                                                                      });
+                if (!inserted && it2->second.original != shape[axis]) {
+                    conflicts.insert(symbol);
+                }
+            }
+        }
+        for (const auto &symbol : conflicts) {
+            dimensions.erase(symbol);
+        }
+        for (auto it = dimensions.begin(); it != dimensions.end();) {
+            if (it->second.padded == it->second.original) {
+                it = dimensions.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        if (dimensions.empty()) {
+            return input;
+        }
+
+        auto result = srt::NO<Api::Onnx::SessionStartInput>::create();
+        result->inputs = input->inputs;
+        result->outputs = input->outputs;
+        result->outputBuffers = input->outputBuffers;
+        result->copyInputs = input->copyInputs;
+        result->cancellationToken = input->cancellationToken;
+        result->deadline = input->deadline;
+        result->bindingPlan = input->bindingPlan;
+        result->inputSlots = input->inputSlots;
+        for (size_t i = 0; i < image.inputNames.size(); ++i) {
+            auto tensor = findInput(*result, image.inputNames[i]);
+            if (!tensor) {
+                continue;
+            }
+            const auto &symbols = image.inputInfos[i].symbolicShape;
+            auto shape = (*tensor)->shape();
+            bool padded = false;
+            for (size_t axis = 0; axis < symbols.size() && axis < shape.size(); ++axis) {
+                if (auto it2 = dimensions.find(symbols[axis]); it2 != dimensions.end()) {
+                    shape[axis] = it2->second.padded;
+                    padded = true;
+                }
+            }
+            if (!padded) {
+                continue;
+            }
+            auto exp = resizeTensor(*tensor, shape);
+            if (!exp) {
+                return exp.takeError();
+            }
+            *tensor = exp.take();
+        }
+        return result;
+    }
+
+    static srt::Expected<void> trimOutput(const SessionImage &image,
+                                          const BucketedDimensions &dimensions,
+                                          const std::string &name, srt::NO<ITensor> &tensor) {
+        auto it = std::find(image.outputNames.begin(), image.outputNames.end(), name);
+        if (it == image.outputNames.end() || !tensor) {
+            return srt::Expected<void>();
+        }
+        const auto &outputInfo = image.outputInfos[it - image.outputNames.begin()];
+        auto shape = tensor->shape();
+        auto trimmedShape = shape;
+        for (size_t axis = 0; axis < shape.size(); ++axis) {
+            const auto *symbol =
+                axis < outputInfo.symbolicShape.size() ? &outputInfo.symbolicShape[axis]
+                                                       : nullptr;
+            if (symbol) {
+                if (auto it2 = dimensions.find(*symbol); it2 != dimensions.end()) {
+                    trimmedShape[axis] = std::min(shape[axis], it2->second.original);
+                    continue;
+                }
+            }
+
+            // A dynamic axis that scaled with a single padded dimension
+            if (dimensions.size() != 1 || axis >= outputInfo.shape.size() ||
+                outputInfo.shape[axis] >= 0) {
+                continue;
+            }
+            const auto &dim = dimensions.begin()->second;
+            if (shape[axis] >= dim.padded && shape[axis] % dim.padded == 0) {
+                trimmedShape[axis] = shape[axis] / dim.padded * dim.original;
+            }
+        }
+        if (trimmedShape == shape) {
+            return srt::Expected<void>();
+        }
+        auto exp = resizeTensor(tensor, trimmedShape);
+        if (!exp) {
+            return exp.takeError();
+        }
+        tensor = exp.take();
+        return srt::Expected<void>();
+    }
+
+    srt::Expected<void> trimOutputs(const SessionImage &image,
+                                    const BucketedDimensions &dimensions,
+                                    Api::Onnx::SessionResult &result,
+                                    const Api::Onnx::SessionBindingPlan *plan) {
+        if (dimensions.empty()) {
+            return srt::Expected<void>();
+        }
+
+        if (plan) {
+            for (size_t i = 0; i < result.outputSlots.size() && i < plan->outputs.size(); ++i) {
+                if (auto exp = trimOutput(image, dimensions, plan->outputs[i],
+                                          result.outputSlots[i]);
+                    !exp) {
+                    return exp;
+                }
+            }
+            return srt::Expected<void>();
+        }
+        for (auto &[name, tensor] : result.outputs) {
+            if (auto exp = trimOutput(image, dimensions, name, tensor); !exp) {
+                return exp;
+            }
+        }
+        return srt::Expected<void>();
+    }
+
+}
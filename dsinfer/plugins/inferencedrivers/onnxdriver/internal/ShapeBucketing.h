@@ -0,0 +1,55 @@
+#ifndef DSINFER_ONNXDRIVER_SHAPEBUCKETING_H
+#define DSINFER_ONNXDRIVER_SHAPEBUCKETING_H
+
+#include <map>
+#include <set>
+#include <string>
+
+#include <synthrt/Support/Expected.h>
+#include <dsinfer/Api/Drivers/Onnx/OnnxDriverApi.h>
+
+namespace ds::onnxdriver {
+
+    class SessionImage;
+
+    struct ShapeBucketingPolicy {
+        Api::Onnx::ShapeBucketing mode = Api::Onnx::NoShapeBucketing;
+        int64_t bucketSize = 0;
+        std::set<std::string> dimensions;
+
+        static ShapeBucketingPolicy fromOpenArgs(const Api::Onnx::SessionOpenArgs &args);
+
+        inline bool isEnabled() const {
+            return mode != Api::Onnx::NoShapeBucketing && bucketSize > 0 && !dimensions.empty();
+        }
+
+        // Returns the bucket that a dimension of the given size is padded to.
+        int64_t bucket(int64_t size) const;
+    };
+
+    struct BucketedDimension {
+        int64_t original;
+        int64_t padded;
+    };
+
+    // Symbolic dimension name -> sizes
+    using BucketedDimensions = std::map<std::string, BucketedDimension>;
+
+    // Returns a copy of the start input with the bucketed axes of the inputs padded, and fills
+    // the padded dimensions. Returns the input itself if there is nothing to pad. The inputs
+    // of a run with a binding plan are padded in their slots.
+    srt::Expected<srt::NO<Api::Onnx::SessionStartInput>>
+        padInputs(const ShapeBucketingPolicy &policy, const SessionImage &image,
+                  const srt::NO<Api::Onnx::SessionStartInput> &input,
+                  BucketedDimensions &dimensions);
+
+    // Trims the outputs of a run with padded inputs back to the original lengths. With a
+    // binding plan, the outputs are taken from the slots of the result.
+    srt::Expected<void> trimOutputs(const SessionImage &image,
+                                    const BucketedDimensions &dimensions,
+                                    Api::Onnx::SessionResult &result,
+                                    const Api::Onnx::SessionBindingPlan *plan = nullptr);
+
+}
+
+#endif // DSINFER_ONNXDRIVER_SHAPEBUCKETING_H
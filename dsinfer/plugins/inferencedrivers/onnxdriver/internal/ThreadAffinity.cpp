@@ -0,0 +1,51 @@
+#include "ThreadAffinity.h"
+
+#ifdef _WIN32
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#elif defined(__linux__)
+#  include <pthread.h>
+#endif
+
+namespace ds::onnxdriver {
+
+    ScopedThreadAffinity::ScopedThreadAffinity(int core) {
+        if (core < 0) {
+            return;
+        }
+#ifdef _WIN32
+        // Only the processors of the group of the thread can be given in the mask
+        if (core >= static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+            return;
+        }
+        auto previousMask = ::SetThreadAffinityMask(::GetCurrentThread(), DWORD_PTR(1) << core);
+        if (previousMask != 0) {
+            _previousMask = previousMask;
+            _pinned = true;
+        }
+#elif defined(__linux__)
+        if (core >= CPU_SETSIZE ||
+            ::pthread_getaffinity_np(::pthread_self(), sizeof(_previousSet), &_previousSet) != 0) {
+            return;
+        }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(core, &set);
+        _pinned = ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) == 0;
+#endif
+    }
+
+    ScopedThreadAffinity::~ScopedThreadAffinity() {
+        if (!_pinned) {
+            return;
+        }
+#ifdef _WIN32
+        ::SetThreadAffinityMask(::GetCurrentThread(), static_cast<DWORD_PTR>(_previousMask));
+#elif defined(__linux__)
+        ::pthread_setaffinity_np(::pthread_self(), sizeof(_previousSet), &_previousSet);
+#endif
+    }
+
+}
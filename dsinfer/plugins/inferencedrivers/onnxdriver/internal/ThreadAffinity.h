@@ -0,0 +1,34 @@
+#ifndef DSINFER_ONNXDRIVER_THREADAFFINITY_H
+#define DSINFER_ONNXDRIVER_THREADAFFINITY_H
+
+#include <cstdint>
+
+#if defined(__linux__)
+#  include <sched.h>
+#endif
+
+namespace ds::onnxdriver {
+
+    // Pins the calling thread to a logical processor (starting from 0) while the object is
+    // alive, and restores the previous affinity when destroyed. Does nothing if the processor
+    // is negative, or where threads cannot be pinned.
+    class ScopedThreadAffinity {
+    public:
+        explicit ScopedThreadAffinity(int core);
+        ~ScopedThreadAffinity();
+
+        ScopedThreadAffinity(const ScopedThreadAffinity &) = delete;
+        ScopedThreadAffinity &operator=(const ScopedThreadAffinity &) = delete;
+
+    private:
+        bool _pinned = false;
+#if defined(_WIN32)
+        uintptr_t _previousMask = 0;
+#elif defined(__linux__)
+        cpu_set_t _previousSet;
+#endif
+    };
+
+}
+
+#endif // DSINFER_ONNXDRIVER_THREADAFFINITY_H
@@ -18,6 +18,7 @@
 #include <dsinfer/Core/Tensor.h>
 
 #include <inferutil/Driver.h>
+#include <inferutil/SessionBinding.h>
 #include <inferutil/Algorithm.h>
 #include <inferutil/TensorHelper.h>
 #include <inferutil/InputWord.h>
@@ -45,11 +46,36 @@ namespace ds {
         return genericConfig.as<Ac::AcousticConfiguration>();
     }
 
+    // The ports of the acoustic model by binding index
+    enum AcousticInput {
+        AI_Tokens,
+        AI_Languages,
+        AI_Durations,
+        AI_Acceleration,
+        AI_Depth,
+        AI_Gender,
+        AI_Velocity,
+        AI_Energy,
+        AI_Breathiness,
+        AI_Voicing,
+        AI_Tension,
+        AI_MouthOpening,
+        AI_F0,
+        AI_SpkEmbed,
+        AI_Count,
+    };
+
+    enum AcousticOutput {
+        AO_Mel,
+        AO_Count,
+    };
+
     class AcousticInference::Impl {
     public:
         srt::NO<Ac::AcousticResult> result;
         srt::NO<InferenceDriver> driver;
         srt::NO<InferenceSession> session;
+        inferutil::SessionBinding binding;
         mutable std::shared_mutex mutex;
     };
 
@@ -96,12 +122,48 @@ namespace ds {
 
         // Open acoustic session
         impl.session = impl.driver->createSession();
+        impl.binding.reset();
         auto sessionOpenArgs = srt::NO<Onnx::SessionOpenArgs>::create();
         sessionOpenArgs->useCpu = false;
         if (auto res = impl.session->open(config->model, sessionOpenArgs); !res) {
             setState(Failed);
             return res;
         }
+        {
+            const auto hasParam = [&](const ParamTag &tag) -> bool {
+                return config->parameters.find(tag) != config->parameters.end();
+            };
+            const std::pair<ParamTag, AcousticInput> params[] = {
+                {Co::Tags::Gender, AI_Gender},
+                {Co::Tags::Velocity, AI_Velocity},
+                {Co::Tags::Energy, AI_Energy},
+                {Co::Tags::Breathiness, AI_Breathiness},
+                {Co::Tags::Voicing, AI_Voicing},
+                {Co::Tags::Tension, AI_Tension},
+                {Co::Tags::MouthOpening, AI_MouthOpening},
+            };
+
+            std::vector<std::string> inputs(AI_Count);
+            inputs[AI_Tokens] = "tokens";
+            if (config->useLanguageId) {
+                inputs[AI_Languages] = "languages";
+            }
+            inputs[AI_Durations] = "durations";
+            inputs[AI_Acceleration] = config->useContinuousAcceleration ? "steps" : "speedup";
+            inputs[AI_Depth] = "depth";
+            for (const auto &[tag, port] : params) {
+                if (hasParam(tag)) {
+                    inputs[port] = tag.name();
+                }
+            }
+            inputs[AI_F0] = "f0";
+            if (config->useSpeakerEmbedding) {
+                inputs[AI_SpkEmbed] = "spk_embed";
+            }
+            std::vector<std::string> outputs(AO_Count);
+            outputs[AO_Mel] = "mel";
+            impl.binding.create(*impl.session, std::move(inputs), std::move(outputs));
+        }
 
         // Initialize inference state
         setState(Idle);
@@ -149,7 +211,13 @@ namespace ds {
         const auto acousticInput = input.as<Ac::AcousticStartInput>();
         // ...
 
-        auto sessionInput = srt::NO<Onnx::SessionStartInput>::create();
+        std::shared_lock<std::shared_mutex> lock(impl.mutex);
+        if (!impl.session || !impl.session->isOpen()) {
+            setState(Failed);
+            return srt::Error(srt::Error::SessionError, "acoustic session is not initialized");
+        }
+
+        auto sessionInput = impl.binding.createInput();
 
         double frameWidth = 1.0 * config->hopSize / config->sampleRate;
 
@@ -157,7 +225,7 @@ namespace ds {
         if (auto res =
                 inferutil::preprocessPhonemeTokens(acousticInput->words, config->phonemes);
             res) {
-            sessionInput->inputs["tokens"] = res.take();
+            impl.binding.setInput(*sessionInput, AI_Tokens, res.take());
         } else {
             setState(Failed);
             return res.takeError();
@@ -168,7 +236,7 @@ namespace ds {
             if (auto res = inferutil::preprocessPhonemeLanguages(acousticInput->words,
                                                                          config->languages);
                 res) {
-                sessionInput->inputs["languages"] = res.take();
+                impl.binding.setInput(*sessionInput, AI_Languages, res.take());
             } else {
                 setState(Failed);
                 return res.takeError();
@@ -181,7 +249,7 @@ namespace ds {
         if (auto res = inferutil::preprocessPhonemeDurations(acousticInput->words,
                                                                      frameWidth, &targetLength);
             res) {
-            sessionInput->inputs["durations"] = res.take();
+            impl.binding.setInput(*sessionInput, AI_Durations, res.take());
         } else {
             setState(Failed);
             return res.takeError();
@@ -198,11 +266,7 @@ namespace ds {
                 setState(Failed);
                 return exp.takeError();
             }
-            if (config->useContinuousAcceleration) {
-                sessionInput->inputs["steps"] = exp.take();
-            } else {
-                sessionInput->inputs["speedup"] = exp.take();
-            }
+            impl.binding.setInput(*sessionInput, AI_Acceleration, exp.take());
         }
 
         // input param: depth
@@ -212,7 +276,7 @@ namespace ds {
                 setState(Failed);
                 return exp.takeError();
             }
-            sessionInput->inputs["depth"] = exp.take();
+            impl.binding.setInput(*sessionInput, AI_Depth, exp.take());
         } else {
             int64_t intDepth = std::llround(acousticInput->depth * 1000);
             intDepth = (std::min) (intDepth, static_cast<int64_t>(config->maxDepth));
@@ -224,7 +288,7 @@ namespace ds {
                 setState(Failed);
                 return exp.takeError();
             }
-            sessionInput->inputs["depth"] = exp.take();
+            impl.binding.setInput(*sessionInput, AI_Depth, exp.take());
         }
 
         // We define some requirements according to config.
@@ -283,7 +347,7 @@ namespace ds {
                         setState(Failed);
                         return exp.takeError();
                     }
-                    sessionInput->inputs["gender"] = exp.take();
+                    impl.binding.setInput(*sessionInput, AI_Gender, exp.take());
                     satisfyGender = true;
                     continue;
                 }
@@ -295,7 +359,7 @@ namespace ds {
                         setState(Failed);
                         return exp.takeError();
                     }
-                    sessionInput->inputs["velocity"] = exp.take();
+                    impl.binding.setInput(*sessionInput, AI_Velocity, exp.take());
                     satisfyVelocity = true;
                     continue;
                 }
@@ -319,37 +383,37 @@ namespace ds {
                 helper.writeUnchecked(static_cast<float>(item));
             }
             if (!satisfyGender && param.tag == Co::Tags::Gender) {
-                sessionInput->inputs["gender"] = helper.take();
+                impl.binding.setInput(*sessionInput, AI_Gender, helper.take());
                 satisfyGender = true;
                 continue;
             }
             if (!satisfyVelocity && param.tag == Co::Tags::Velocity) {
-                sessionInput->inputs["velocity"] = helper.take();
+                impl.binding.setInput(*sessionInput, AI_Velocity, helper.take());
                 satisfyVelocity = true;
                 continue;
             }
             if (!satisfyEnergy && param.tag == Co::Tags::Energy) {
-                sessionInput->inputs["energy"] = helper.take();
+                impl.binding.setInput(*sessionInput, AI_Energy, helper.take());
                 satisfyEnergy = true;
                 continue;
             }
             if (!satisfyBreathiness && param.tag == Co::Tags::Breathiness) {
-                sessionInput->inputs["breathiness"] = helper.take();
+                impl.binding.setInput(*sessionInput, AI_Breathiness, helper.take());
                 satisfyBreathiness = true;
                 continue;
             }
             if (!satisfyVoicing && param.tag == Co::Tags::Voicing) {
-                sessionInput->inputs["voicing"] = helper.take();
+                impl.binding.setInput(*sessionInput, AI_Voicing, helper.take());
                 satisfyVoicing = true;
                 continue;
             }
             if (!satisfyTension && param.tag == Co::Tags::Tension) {
-                sessionInput->inputs["tension"] = helper.take();
+                impl.binding.setInput(*sessionInput, AI_Tension, helper.take());
                 satisfyTension = true;
                 continue;
             }
             if (!satisfyMouthOpening && param.tag == Co::Tags::MouthOpening) {
-                sessionInput->inputs["mouth_opening"] = helper.take();
+                impl.binding.setInput(*sessionInput, AI_MouthOpening, helper.take());
                 satisfyMouthOpening = true;
                 continue;
             }
@@ -414,7 +478,7 @@ namespace ds {
                 }
             }
             f0TensorForVocoder = acousticHelper.take();
-            sessionInput->inputs["f0"] = f0TensorForVocoder; // ref count +1
+            impl.binding.setInput(*sessionInput, AI_F0, f0TensorForVocoder); // ref count +1
             return srt::Expected<void>();
         };
 
@@ -462,7 +526,7 @@ namespace ds {
                 acousticInput->speakers, config->speakers, config->hiddenSize, frameWidth,
                 targetLength);
             if (exp) {
-                sessionInput->inputs["spk_embed"] = exp.take();
+                impl.binding.setInput(*sessionInput, AI_SpkEmbed, exp.take());
             } else {
                 setState(Failed);
                 return exp.takeError();
@@ -471,15 +535,6 @@ namespace ds {
             // Nothing to do: speaker embedding is not supported
         }
 
-        constexpr const char *outParamMel = "mel";
-        sessionInput->outputs.emplace(outParamMel);
-
-        std::unique_lock<std::shared_mutex> lock(impl.mutex);
-        if (!impl.session || !impl.session->isOpen()) {
-            setState(Failed);
-            return srt::Error(srt::Error::SessionError, "acoustic session is not initialized");
-        }
-
         srt::NO<srt::TaskResult> sessionTaskResult;
         auto sessionExp = impl.session->start(sessionInput);
         if (!sessionExp) {
@@ -501,15 +556,19 @@ namespace ds {
             return srt::Error(srt::Error::InvalidArgument, "invalid result API name");
         }
         auto sessionResult = sessionTaskResult.as<Onnx::SessionResult>();
-        if (auto it_mel = sessionResult->outputs.find(outParamMel);
-            it_mel != sessionResult->outputs.end()) {
-            acousticResult->mel = it_mel->second;
+        if (auto mel = impl.binding.output(*sessionResult, AO_Mel)) {
+            acousticResult->mel = std::move(mel);
         } else {
             setState(Failed);
             return srt::Error(srt::Error::SessionError, "invalid result output");
         }
         acousticResult->f0 = f0TensorForVocoder;
-        impl.result = acousticResult;
+        // Sessions can run concurrently, only publishing the result is exclusive
+        lock.unlock();
+        {
+            std::unique_lock<std::shared_mutex> resultLock(impl.mutex);
+            impl.result = acousticResult;
+        }
 
         setState(Idle);
         return acousticResult;
@@ -22,6 +22,7 @@
 #include <inferutil/Driver.h>
 #include <inferutil/InputWord.h>
 #include <inferutil/LinguisticEncoder.h>
+#include <inferutil/SessionBinding.h>
 #include <inferutil/Algorithm.h>
 
 namespace ds {
@@ -94,12 +95,28 @@ namespace ds {
         }
     }
 
+    // The ports of the duration predictor model by binding index
+    enum DurationInput {
+        DI_EncoderOut,
+        DI_XMasks,
+        DI_PhMidi,
+        DI_SpkEmbed,
+        DI_Count,
+    };
+
+    enum DurationOutput {
+        DO_PhDurPred,
+        DO_Count,
+    };
+
     class DurationInference::Impl {
     public:
         srt::NO<Dur::DurationResult> result;
         srt::NO<InferenceDriver> driver;
         srt::NO<InferenceSession> encoderSession;
         srt::NO<InferenceSession> predictorSession;
+        inferutil::SessionBinding encoderBinding;
+        inferutil::SessionBinding predictorBinding;
         mutable std::shared_mutex mutex;
     };
 
@@ -146,21 +163,38 @@ namespace ds {
 
         // Open duration session (encoder)
         impl.encoderSession = impl.driver->createSession();
+        impl.encoderBinding.reset();
         auto encoderOpenArgs = srt::NO<Onnx::SessionOpenArgs>::create();
         encoderOpenArgs->useCpu = false;
         if (auto res = impl.encoderSession->open(config->encoder, encoderOpenArgs); !res) {
             setState(Failed);
             return res;
         }
+        inferutil::createLinguisticEncoderBinding(impl.encoderBinding, *impl.encoderSession,
+                                                  Co::LM_Word, config->useLanguageId);
 
         // Open duration session (predictor)
         impl.predictorSession = impl.driver->createSession();
+        impl.predictorBinding.reset();
         auto predictorOpenArgs = srt::NO<Onnx::SessionOpenArgs>::create();
         predictorOpenArgs->useCpu = false;
         if (auto res = impl.predictorSession->open(config->predictor, predictorOpenArgs); !res) {
             setState(Failed);
             return res;
         }
+        {
+            std::vector<std::string> inputs(DI_Count);
+            inputs[DI_EncoderOut] = "encoder_out";
+            inputs[DI_XMasks] = "x_masks";
+            inputs[DI_PhMidi] = "ph_midi";
+            if (config->useSpeakerEmbedding) {
+                inputs[DI_SpkEmbed] = "spk_embed";
+            }
+            std::vector<std::string> outputs(DO_Count);
+            outputs[DO_PhDurPred] = "ph_dur_pred";
+            impl.predictorBinding.create(*impl.predictorSession, std::move(inputs),
+                                         std::move(outputs));
+        }
 
         // Initialize inference state
         setState(Idle);
@@ -208,29 +242,35 @@ namespace ds {
         auto durationInput = input.as<Dur::DurationStartInput>();
         // ...
 
-        auto sessionInput = srt::NO<Onnx::SessionStartInput>::create();
-
         double frameWidth = config->frameWidth;
         if (!std::isfinite(frameWidth) || frameWidth <= 0) {
             setState(Failed);
             return srt::Error(srt::Error::InvalidArgument, "frame width must be positive");
         }
 
+        std::shared_lock<std::shared_mutex> lock(impl.mutex);
+        if (!impl.encoderSession || !impl.encoderSession->isOpen()) {
+            setState(Failed);
+            return srt::Error(srt::Error::SessionError,
+                              "duration linguistic encoder session is not initialized");
+        }
+        if (!impl.predictorSession || !impl.predictorSession->isOpen()) {
+            setState(Failed);
+            return srt::Error(srt::Error::SessionError,
+                              "duration predictor session is not initialized");
+        }
+
+        auto sessionInput = impl.predictorBinding.createInput();
+
         // Part 1: Linguistic Encoder Inference
         if (auto exp = inferutil::preprocessLinguisticWord(
-                durationInput->words, config->phonemes, config->languages, config->useLanguageId,
-                frameWidth);
+                impl.encoderBinding, durationInput->words, config->phonemes, config->languages,
+                config->useLanguageId, frameWidth);
             exp) {
             // Run Linguistic Encoder Inference
-            std::unique_lock<std::shared_mutex> lock(impl.mutex);
-            if (!impl.encoderSession || !impl.encoderSession->isOpen()) {
-                setState(Failed);
-                return srt::Error(srt::Error::SessionError,
-                                  "duration linguistic encoder session is not initialized");
-            }
-            if (auto encoderSessionExp =
-                    inferutil::runEncoder(impl.encoderSession, exp.take(),
-                                                  /* out */ sessionInput);
+            if (auto encoderSessionExp = inferutil::runEncoder(
+                    impl.encoderSession, impl.encoderBinding, exp.take(), impl.predictorBinding,
+                    /* out */ *sessionInput, DI_EncoderOut, DI_XMasks);
                 !encoderSessionExp) {
                 setState(Failed);
                 return encoderSessionExp.takeError();
@@ -242,7 +282,7 @@ namespace ds {
 
         // Part 2: Duration Inference
         if (auto exp = preprocessPhonemeMidi(durationInput->words); exp) {
-            sessionInput->inputs["ph_midi"] = exp.take();
+            impl.predictorBinding.setInput(*sessionInput, DI_PhMidi, exp.take());
         } else {
             setState(Failed);
             return exp.takeError();
@@ -291,7 +331,7 @@ namespace ds {
                         ++currPhoneIndex;
                     }
                 }
-                sessionInput->inputs["spk_embed"] = tensor;
+                impl.predictorBinding.setInput(*sessionInput, DI_SpkEmbed, tensor);
             } else {
                 return exp.takeError();
             }
@@ -299,16 +339,6 @@ namespace ds {
             // Nothing to do: speaker embedding is not supported
         }
 
-        constexpr const char *outParamPhDurPred = "ph_dur_pred";
-        sessionInput->outputs.emplace(outParamPhDurPred);
-
-        std::unique_lock<std::shared_mutex> lock(impl.mutex);
-        if (!impl.predictorSession || !impl.predictorSession->isOpen()) {
-            setState(Failed);
-            return srt::Error(srt::Error::SessionError,
-                              "duration predictor session is not initialized");
-        }
-
         srt::NO<srt::TaskResult> sessionTaskResult;
         auto sessionExp = impl.predictorSession->start(sessionInput);
         if (!sessionExp) {
@@ -331,10 +361,8 @@ namespace ds {
             return srt::Error(srt::Error::InvalidArgument, "invalid result API name");
         }
         auto sessionResult = sessionTaskResult.as<Onnx::SessionResult>();
-        if (auto it_pred = sessionResult->outputs.find(outParamPhDurPred);
-            it_pred != sessionResult->outputs.end()) {
+        if (auto output = impl.predictorBinding.output(*sessionResult, DO_PhDurPred)) {
             // Extract onnx model result and copy to duration final result vector (float -> double)
-            auto output = std::move(it_pred->second);
             if (output->dataType() != ITensor::Float) {
                 setState(Failed);
                 return srt::Error(srt::Error::SessionError, "model output is not float");
@@ -390,7 +418,12 @@ namespace ds {
                               stdc::formatN("predicted phoneme count mismatch: expected %1, got %2",
                                             phoneCount, predictedPhoneCount));
         }
-        impl.result = durationResult;
+        // Sessions can run concurrently, only publishing the result is exclusive
+        lock.unlock();
+        {
+            std::unique_lock<std::shared_mutex> resultLock(impl.mutex);
+            impl.result = durationResult;
+        }
 
         setState(Idle);
         return durationResult;
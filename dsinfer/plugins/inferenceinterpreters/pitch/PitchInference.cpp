@@ -22,6 +22,7 @@
 #include <inferutil/Algorithm.h>
 #include <inferutil/InputWord.h>
 #include <inferutil/LinguisticEncoder.h>
+#include <inferutil/SessionBinding.h>
 #include <inferutil/SpeakerEmbedding.h>
 #include <inferutil/Speedup.h>
 
@@ -46,12 +47,34 @@ namespace ds {
         return genericConfig.as<Pit::PitchConfiguration>();
     }
 
+    // The ports of the pitch predictor model by binding index
+    enum PitchInput {
+        PI_EncoderOut,
+        PI_NoteMidi,
+        PI_NoteRest,
+        PI_NoteDur,
+        PI_PhDur,
+        PI_Pitch,
+        PI_Retake,
+        PI_Expr,
+        PI_SpkEmbed,
+        PI_Acceleration,
+        PI_Count,
+    };
+
+    enum PitchOutput {
+        PO_PitchPred,
+        PO_Count,
+    };
+
     class PitchInference::Impl {
     public:
         srt::NO<Pit::PitchResult> result;
         srt::NO<InferenceDriver> driver;
         srt::NO<InferenceSession> encoderSession;
         srt::NO<InferenceSession> predictorSession;
+        inferutil::SessionBinding encoderBinding;
+        inferutil::SessionBinding predictorBinding;
         mutable std::shared_mutex mutex;
     };
 
@@ -98,21 +121,48 @@ namespace ds {
 
         // Open pitch session (encoder)
         impl.encoderSession = impl.driver->createSession();
+        impl.encoderBinding.reset();
         auto encoderOpenArgs = srt::NO<Onnx::SessionOpenArgs>::create();
         encoderOpenArgs->useCpu = false;
         if (auto res = impl.encoderSession->open(config->encoder, encoderOpenArgs); !res) {
             setState(Failed);
             return res;
         }
+        inferutil::createLinguisticEncoderBinding(impl.encoderBinding, *impl.encoderSession,
+                                                  config->linguisticMode, config->useLanguageId);
 
         // Open pitch session (predictor)
         impl.predictorSession = impl.driver->createSession();
+        impl.predictorBinding.reset();
         auto predictorOpenArgs = srt::NO<Onnx::SessionOpenArgs>::create();
         predictorOpenArgs->useCpu = false;
         if (auto res = impl.predictorSession->open(config->predictor, predictorOpenArgs); !res) {
             setState(Failed);
             return res;
         }
+        {
+            std::vector<std::string> inputs(PI_Count);
+            inputs[PI_EncoderOut] = "encoder_out";
+            inputs[PI_NoteMidi] = "note_midi";
+            if (config->useRestFlags) {
+                inputs[PI_NoteRest] = "note_rest";
+            }
+            inputs[PI_NoteDur] = "note_dur";
+            inputs[PI_PhDur] = "ph_dur";
+            inputs[PI_Pitch] = "pitch";
+            inputs[PI_Retake] = "retake";
+            if (config->useExpressiveness) {
+                inputs[PI_Expr] = "expr";
+            }
+            if (config->useSpeakerEmbedding) {
+                inputs[PI_SpkEmbed] = "spk_embed";
+            }
+            inputs[PI_Acceleration] = config->useContinuousAcceleration ? "steps" : "speedup";
+            std::vector<std::string> outputs(PO_Count);
+            outputs[PO_PitchPred] = "pitch_pred";
+            impl.predictorBinding.create(*impl.predictorSession, std::move(inputs),
+                                         std::move(outputs));
+        }
 
         // Initialize inference state
         setState(Idle);
@@ -158,22 +208,34 @@ namespace ds {
         auto pitchInput = input.as<Pit::PitchStartInput>();
         // ...
 
-        auto sessionInput = srt::NO<Onnx::SessionStartInput>::create();
-
         double frameWidth = config->frameWidth;
         if (!std::isfinite(frameWidth) || frameWidth <= 0) {
             setState(Failed);
             return srt::Error(srt::Error::InvalidArgument, "frame width must be positive");
         }
 
+        std::shared_lock<std::shared_mutex> lock(impl.mutex);
+        if (!impl.encoderSession || !impl.encoderSession->isOpen()) {
+            setState(Failed);
+            return srt::Error(srt::Error::SessionError,
+                              "pitch linguistic encoder session is not initialized");
+        }
+        if (!impl.predictorSession || !impl.predictorSession->isOpen()) {
+            setState(Failed);
+            return srt::Error(srt::Error::SessionError,
+                              "pitch predictor session is not initialized");
+        }
+
+        auto sessionInput = impl.predictorBinding.createInput();
+
         // Part 1: Linguistic Encoder Inference
         {
             srt::NO<Onnx::SessionStartInput> linguisticInput;
             switch (config->linguisticMode) {
                 case Co::LinguisticMode::LM_Word:
                     if (auto exp = inferutil::preprocessLinguisticWord(
-                            pitchInput->words, config->phonemes, config->languages,
-                            config->useLanguageId, frameWidth);
+                            impl.encoderBinding, pitchInput->words, config->phonemes,
+                            config->languages, config->useLanguageId, frameWidth);
                         exp) {
                         linguisticInput = exp.take();
                     } else {
@@ -183,8 +245,8 @@ namespace ds {
                     break;
                 case Co::LinguisticMode::LM_Phoneme:
                     if (auto exp = inferutil::preprocessLinguisticPhoneme(
-                            pitchInput->words, config->phonemes, config->languages,
-                            config->useLanguageId, frameWidth);
+                            impl.encoderBinding, pitchInput->words, config->phonemes,
+                            config->languages, config->useLanguageId, frameWidth);
                         exp) {
                         linguisticInput = exp.take();
                     } else {
@@ -198,15 +260,9 @@ namespace ds {
             }
 
             // Run Linguistic Encoder Inference
-            std::unique_lock<std::shared_mutex> lock(impl.mutex);
-            if (!impl.encoderSession || !impl.encoderSession->isOpen()) {
-                setState(Failed);
-                return srt::Error(srt::Error::SessionError,
-                                  "pitch linguistic encoder session is not initialized");
-            }
-            if (auto encoderSessionExp =
-                    inferutil::runEncoder(impl.encoderSession, linguisticInput,
-                                                  /* out */ sessionInput, false);
+            if (auto encoderSessionExp = inferutil::runEncoder(
+                    impl.encoderSession, impl.encoderBinding, linguisticInput,
+                    impl.predictorBinding, /* out */ *sessionInput, PI_EncoderOut);
                 !encoderSessionExp) {
                 setState(Failed);
                 return encoderSessionExp.takeError();
@@ -251,7 +307,7 @@ namespace ds {
         };
 
         if (auto exp = tensorFrom1DArray(noteMidi); exp) {
-            sessionInput->inputs.emplace("note_midi", exp.take());
+            impl.predictorBinding.setInput(*sessionInput, PI_NoteMidi, exp.take());
         } else {
             setState(Failed);
             return exp.takeError();
@@ -265,7 +321,7 @@ namespace ds {
             auto exp =
                 Tensor::createFromRawData(ITensor::Bool, shape, std::move(noteRestContainer));
             if (exp) {
-                sessionInput->inputs.emplace("note_rest", exp.take());
+                impl.predictorBinding.setInput(*sessionInput, PI_NoteRest, exp.take());
             } else {
                 setState(Failed);
                 return exp.takeError();
@@ -273,7 +329,7 @@ namespace ds {
         }
 
         if (auto exp = tensorFrom1DArray(noteDur); exp) {
-            sessionInput->inputs.emplace("note_dur", exp.take());
+            impl.predictorBinding.setInput(*sessionInput, PI_NoteDur, exp.take());
         } else {
             setState(Failed);
             return exp.takeError();
@@ -282,7 +338,7 @@ namespace ds {
         if (auto exp = inferutil::preprocessPhonemeDurations(pitchInput->words,
                                                                      config->frameWidth);
             exp) {
-            sessionInput->inputs.emplace("ph_dur", exp.take());
+            impl.predictorBinding.setInput(*sessionInput, PI_PhDur, exp.take());
         } else {
             setState(Failed);
             return exp.takeError();
@@ -307,7 +363,7 @@ namespace ds {
             }
 
             if (isPitch) {
-                if (auto exp = Tensor::create(ITensor::Float, {1, targetLength}); exp) {
+                if (auto exp = Tensor::createUninitialized(ITensor::Float, {1, targetLength}); exp) {
                     auto pitchTensor = exp.take();
                     if (pitchTensor->elementCount() != targetLength) {
                         setState(Failed);
@@ -324,7 +380,7 @@ namespace ds {
                     for (size_t i = 0; i < targetLength; ++i) {
                         pitchBuffer[i] = static_cast<float>(samples[i]);
                     }
-                    sessionInput->inputs.emplace("pitch", std::move(pitchTensor));
+                    impl.predictorBinding.setInput(*sessionInput, PI_Pitch, std::move(pitchTensor));
                 } else {
                     setState(Failed);
                     return exp.takeError();
@@ -349,14 +405,14 @@ namespace ds {
                 auto exp =
                     Tensor::createFromRawData(ITensor::Bool, {1, targetLength}, std::move(retake));
                 if (exp) {
-                    sessionInput->inputs.emplace("retake", exp.take());
+                    impl.predictorBinding.setInput(*sessionInput, PI_Retake, exp.take());
                 } else {
                     setState(Failed);
                     return exp.takeError();
                 }
                 satisfyPitch = true;
             } else if (!satisfyExpr && isExpr) {
-                if (auto exp = Tensor::create(ITensor::Float, {1, targetLength}); exp) {
+                if (auto exp = Tensor::createUninitialized(ITensor::Float, {1, targetLength}); exp) {
                     auto exprTensor = exp.take();
                     if (exprTensor->elementCount() != targetLength) {
                         setState(Failed);
@@ -371,7 +427,7 @@ namespace ds {
                     for (size_t i = 0; i < targetLength; ++i) {
                         exprBuffer[i] = static_cast<float>(samples[i]);
                     }
-                    sessionInput->inputs.emplace("expr", std::move(exprTensor));
+                    impl.predictorBinding.setInput(*sessionInput, PI_Expr, std::move(exprTensor));
                     satisfyExpr = true;
                 } else {
                     setState(Failed);
@@ -384,7 +440,7 @@ namespace ds {
             // No pitch supplied.
             // Will pass pitch tensor of all zeros and retake tensor of all true values.
             if (auto exp = Tensor::createFilled<float>({1, targetLength}, 0.0f); exp) {
-                sessionInput->inputs.emplace("pitch", exp.take());
+                impl.predictorBinding.setInput(*sessionInput, PI_Pitch, exp.take());
             } else {
                 setState(Failed);
                 return exp.takeError();
@@ -392,7 +448,7 @@ namespace ds {
             if (auto exp = Tensor::createFromRawData(ITensor::Bool, {1, targetLength},
                                                      Tensor::Container(targetLength, std::byte{1}));
                 exp) {
-                sessionInput->inputs.emplace("retake", exp.take());
+                impl.predictorBinding.setInput(*sessionInput, PI_Retake, exp.take());
                 satisfyPitch = true;
             } else {
                 setState(Failed);
@@ -404,7 +460,7 @@ namespace ds {
             // Model needs expr but no expr supplied.
             // Will use all ones instead.
             if (auto exp = Tensor::createFilled<float>({1, targetLength}, 1.0f); exp) {
-                sessionInput->inputs.emplace("expr", exp.take());
+                impl.predictorBinding.setInput(*sessionInput, PI_Expr, exp.take());
                 satisfyExpr = true;
             } else {
                 setState(Failed);
@@ -423,7 +479,7 @@ namespace ds {
                 pitchInput->speakers, config->speakers, config->hiddenSize, frameWidth,
                 targetLength);
             if (exp) {
-                sessionInput->inputs["spk_embed"] = exp.take();
+                impl.predictorBinding.setInput(*sessionInput, PI_SpkEmbed, exp.take());
             } else {
                 setState(Failed);
                 return exp.takeError();
@@ -443,21 +499,7 @@ namespace ds {
                 setState(Failed);
                 return exp.takeError();
             }
-            if (config->useContinuousAcceleration) {
-                sessionInput->inputs["steps"] = exp.take();
-            } else {
-                sessionInput->inputs["speedup"] = exp.take();
-            }
-        }
-
-        constexpr const char *outParamPitchPred = "pitch_pred";
-        sessionInput->outputs.emplace(outParamPitchPred);
-
-        std::unique_lock<std::shared_mutex> lock(impl.mutex);
-        if (!impl.predictorSession || !impl.predictorSession->isOpen()) {
-            setState(Failed);
-            return srt::Error(srt::Error::SessionError,
-                              "pitch predictor session is not initialized");
+            impl.predictorBinding.setInput(*sessionInput, PI_Acceleration, exp.take());
         }
 
         srt::NO<srt::TaskResult> sessionTaskResult;
@@ -482,10 +524,8 @@ namespace ds {
             return srt::Error(srt::Error::InvalidArgument, "invalid result API name");
         }
         auto sessionResult = sessionTaskResult.as<Onnx::SessionResult>();
-        if (auto it_pred = sessionResult->outputs.find(outParamPitchPred);
-            it_pred != sessionResult->outputs.end()) {
+        if (auto output = impl.predictorBinding.output(*sessionResult, PO_PitchPred)) {
             // Extract onnx model result and copy to pitch final result vector (float -> double)
-            auto output = std::move(it_pred->second);
             if (output->dataType() != ITensor::Float) {
                 setState(Failed);
                 return srt::Error(srt::Error::SessionError, "model output is not float");
@@ -501,7 +541,12 @@ namespace ds {
             setState(Failed);
             return srt::Error(srt::Error::SessionError, "invalid result output");
         }
-        impl.result = pitchResult;
+        // Sessions can run concurrently, only publishing the result is exclusive
+        lock.unlock();
+        {
+            std::unique_lock<std::shared_mutex> resultLock(impl.mutex);
+            impl.result = pitchResult;
+        }
 
         setState(Idle);
         return pitchResult;
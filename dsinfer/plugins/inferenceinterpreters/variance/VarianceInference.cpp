@@ -23,6 +23,7 @@
 #include <inferutil/Algorithm.h>
 #include <inferutil/InputWord.h>
 #include <inferutil/LinguisticEncoder.h>
+#include <inferutil/SessionBinding.h>
 #include <inferutil/SpeakerEmbedding.h>
 #include <inferutil/Speedup.h>
 
@@ -61,12 +62,26 @@ namespace ds {
         return genericSchema.as<Var::VarianceSchema>();
     }
 
+    // The ports of the variance predictor model by binding index. The input of the parameter
+    // predicted at output j is at VI_Parameters + j.
+    enum VarianceInput {
+        VI_EncoderOut,
+        VI_PhDur,
+        VI_Pitch,
+        VI_Retake,
+        VI_SpkEmbed,
+        VI_Acceleration,
+        VI_Parameters,
+    };
+
     class VarianceInference::Impl {
     public:
         srt::NO<Var::VarianceResult> result;
         srt::NO<InferenceDriver> driver;
         srt::NO<InferenceSession> encoderSession;
         srt::NO<InferenceSession> predictorSession;
+        inferutil::SessionBinding encoderBinding;
+        inferutil::SessionBinding predictorBinding;
         mutable std::shared_mutex mutex;
     };
 
@@ -111,23 +126,54 @@ namespace ds {
         }
         const auto config = expConfig.take();
 
+        // Get variance schema
+        auto expSchema = getSchema(spec());
+        if (!expSchema) {
+            setState(Failed);
+            return expSchema.takeError();
+        }
+        const auto schema = expSchema.take();
+
         // Open variance session (encoder)
         impl.encoderSession = impl.driver->createSession();
+        impl.encoderBinding.reset();
         auto encoderOpenArgs = srt::NO<Onnx::SessionOpenArgs>::create();
         encoderOpenArgs->useCpu = false;
         if (auto res = impl.encoderSession->open(config->encoder, encoderOpenArgs); !res) {
             setState(Failed);
             return res;
         }
+        inferutil::createLinguisticEncoderBinding(impl.encoderBinding, *impl.encoderSession,
+                                                  config->linguisticMode, config->useLanguageId);
 
         // Open variance session (predictor)
         impl.predictorSession = impl.driver->createSession();
+        impl.predictorBinding.reset();
         auto predictorOpenArgs = srt::NO<Onnx::SessionOpenArgs>::create();
         predictorOpenArgs->useCpu = false;
         if (auto res = impl.predictorSession->open(config->predictor, predictorOpenArgs); !res) {
             setState(Failed);
             return res;
         }
+        {
+            std::vector<std::string> inputs(VI_Parameters + schema->predictions.size());
+            std::vector<std::string> outputs;
+            inputs[VI_EncoderOut] = "encoder_out";
+            inputs[VI_PhDur] = "ph_dur";
+            inputs[VI_Pitch] = "pitch";
+            inputs[VI_Retake] = "retake";
+            if (config->useSpeakerEmbedding) {
+                inputs[VI_SpkEmbed] = "spk_embed";
+            }
+            inputs[VI_Acceleration] = config->useContinuousAcceleration ? "steps" : "speedup";
+            for (size_t j = 0; j < schema->predictions.size(); ++j) {
+                const auto name = std::string(schema->predictions[j].name());
+                inputs[VI_Parameters + j] = name;
+                outputs.push_back(name + "_pred");
+            }
+            impl.predictorBinding.create(*impl.predictorSession, std::move(inputs),
+                                         std::move(outputs));
+        }
 
         // Initialize inference state
         setState(Idle);
@@ -181,22 +227,34 @@ namespace ds {
         const auto varianceInput = input.as<Var::VarianceStartInput>();
         // ...
 
-        auto sessionInput = srt::NO<Onnx::SessionStartInput>::create();
-
         double frameWidth = config->frameWidth;
         if (!std::isfinite(frameWidth) || frameWidth <= 0) {
             setState(Failed);
             return srt::Error(srt::Error::InvalidArgument, "frame width must be positive");
         }
 
+        std::shared_lock<std::shared_mutex> lock(impl.mutex);
+        if (!impl.encoderSession || !impl.encoderSession->isOpen()) {
+            setState(Failed);
+            return srt::Error(srt::Error::SessionError,
+                              "variance linguistic encoder session is not initialized");
+        }
+        if (!impl.predictorSession || !impl.predictorSession->isOpen()) {
+            setState(Failed);
+            return srt::Error(srt::Error::SessionError,
+                              "variance predictor session is not initialized");
+        }
+
+        auto sessionInput = impl.predictorBinding.createInput();
+
         // Part 1: Linguistic Encoder Inference
         {
             srt::NO<Onnx::SessionStartInput> linguisticInput;
             switch (config->linguisticMode) {
                 case Co::LinguisticMode::LM_Word:
                     if (auto exp = inferutil::preprocessLinguisticWord(
-                            varianceInput->words, config->phonemes, config->languages,
-                            config->useLanguageId, frameWidth);
+                            impl.encoderBinding, varianceInput->words, config->phonemes,
+                            config->languages, config->useLanguageId, frameWidth);
                         exp) {
                         linguisticInput = exp.take();
                     } else {
@@ -206,8 +264,8 @@ namespace ds {
                     break;
                 case Co::LinguisticMode::LM_Phoneme:
                     if (auto exp = inferutil::preprocessLinguisticPhoneme(
-                            varianceInput->words, config->phonemes, config->languages,
-                            config->useLanguageId, frameWidth);
+                            impl.encoderBinding, varianceInput->words, config->phonemes,
+                            config->languages, config->useLanguageId, frameWidth);
                         exp) {
                         linguisticInput = exp.take();
                     } else {
@@ -221,15 +279,9 @@ namespace ds {
             }
 
             // Run Linguistic Encoder Inference
-            std::unique_lock<std::shared_mutex> lock(impl.mutex);
-            if (!impl.encoderSession || !impl.encoderSession->isOpen()) {
-                setState(Failed);
-                return srt::Error(srt::Error::SessionError,
-                                  "variance linguistic encoder session is not initialized");
-            }
-            if (auto encoderSessionExp =
-                    inferutil::runEncoder(impl.encoderSession, linguisticInput,
-                                                  /* out */ sessionInput, false);
+            if (auto encoderSessionExp = inferutil::runEncoder(
+                    impl.encoderSession, impl.encoderBinding, linguisticInput,
+                    impl.predictorBinding, /* out */ *sessionInput, VI_EncoderOut);
                 !encoderSessionExp) {
                 setState(Failed);
                 return encoderSessionExp.takeError();
@@ -248,7 +300,7 @@ namespace ds {
         if (auto exp = inferutil::preprocessPhonemeDurations(varianceInput->words,
                                                                      config->frameWidth);
             exp) {
-            sessionInput->inputs.emplace("ph_dur", exp.take());
+            impl.predictorBinding.setInput(*sessionInput, VI_PhDur, exp.take());
         } else {
             setState(Failed);
             return exp.takeError();
@@ -280,7 +332,7 @@ namespace ds {
             }
 
             if (isPitch) {
-                if (auto exp = Tensor::create(ITensor::Float, {1, targetLength}); exp) {
+                if (auto exp = Tensor::createUninitialized(ITensor::Float, {1, targetLength}); exp) {
                     auto pitchTensor = exp.take();
                     if (pitchTensor->elementCount() != targetLength) {
                         setState(Failed);
@@ -297,7 +349,8 @@ namespace ds {
                     for (size_t i = 0; i < targetLength; ++i) {
                         pitchBuffer[i] = static_cast<float>(samples[i]);
                     }
-                    sessionInput->inputs.emplace("pitch", std::move(pitchTensor));
+                    impl.predictorBinding.setInput(*sessionInput, VI_Pitch,
+                                                   std::move(pitchTensor));
                     satisfyPitch = true;
                     continue;
                 } else {
@@ -311,7 +364,7 @@ namespace ds {
                 if (param.tag != prediction) {
                     continue;
                 }
-                if (auto exp = Tensor::create(ITensor::Float, {1, targetLength}); exp) {
+                if (auto exp = Tensor::createUninitialized(ITensor::Float, {1, targetLength}); exp) {
                     auto paramTensor = exp.take();
                     if (paramTensor->elementCount() != targetLength) {
                         setState(Failed);
@@ -328,8 +381,8 @@ namespace ds {
                     for (size_t i = 0; i < targetLength; ++i) {
                         paramBuffer[i] = static_cast<float>(samples[i]);
                     }
-                    sessionInput->inputs.emplace(param.tag.name(), std::move(paramTensor));
-                    sessionInput->outputs.emplace(std::string(param.tag.name()) + "_pred");
+                    impl.predictorBinding.setInput(*sessionInput, VI_Parameters + j,
+                                                   std::move(paramTensor));
                 } else {
                     setState(Failed);
                     return exp.takeError();
@@ -392,7 +445,7 @@ namespace ds {
                 ITensor::Bool, {1, targetLength, static_cast<int64_t>(schema->predictions.size())},
                 std::move(retake));
             exp) {
-            sessionInput->inputs.emplace("retake", exp.take());
+            impl.predictorBinding.setInput(*sessionInput, VI_Retake, exp.take());
         } else {
             setState(Failed);
             return exp.takeError();
@@ -411,8 +464,7 @@ namespace ds {
             // If some parameters are not supplied, fill them with 0
             auto exp = Tensor::createFilled<float>({1, targetLength}, 0.0f);
             if (exp) {
-                sessionInput->inputs.emplace(prediction.name(), exp.take());
-                sessionInput->outputs.emplace(std::string(prediction.name()) + "_pred");
+                impl.predictorBinding.setInput(*sessionInput, VI_Parameters + j, exp.take());
             } else {
                 setState(Failed);
                 return exp.takeError();
@@ -430,7 +482,7 @@ namespace ds {
                 varianceInput->speakers, config->speakers, config->hiddenSize, frameWidth,
                 targetLength);
             if (exp) {
-                sessionInput->inputs["spk_embed"] = exp.take();
+                impl.predictorBinding.setInput(*sessionInput, VI_SpkEmbed, exp.take());
             } else {
                 setState(Failed);
                 return exp.takeError();
@@ -450,18 +502,7 @@ namespace ds {
                 setState(Failed);
                 return exp.takeError();
             }
-            if (config->useContinuousAcceleration) {
-                sessionInput->inputs["steps"] = exp.take();
-            } else {
-                sessionInput->inputs["speedup"] = exp.take();
-            }
-        }
-
-        std::unique_lock<std::shared_mutex> lock(impl.mutex);
-        if (!impl.predictorSession || !impl.predictorSession->isOpen()) {
-            setState(Failed);
-            return srt::Error(srt::Error::SessionError,
-                              "variance predictor session is not initialized");
+            impl.predictorBinding.setInput(*sessionInput, VI_Acceleration, exp.take());
         }
 
         srt::NO<srt::TaskResult> sessionTaskResult;
@@ -486,18 +527,17 @@ namespace ds {
             return srt::Error(srt::Error::InvalidArgument, "invalid result API name");
         }
         auto sessionResult = sessionTaskResult.as<Onnx::SessionResult>();
-        varianceResult->predictions.reserve(sessionResult->outputs.size());
-        for (const auto &[outputName, output] : sessionResult->outputs) {
-            for (const auto &prediction : schema->predictions) {
-                if (outputName != std::string(prediction.name()) + "_pred") {
-                    continue;
-                }
-                const auto view = output->view<float>();
-                Co::InputParameterInfo inputParam{prediction};
-                inputParam.interval = frameWidth;
-                inputParam.values.assign(view.begin(), view.end());
-                varianceResult->predictions.emplace_back(std::move(inputParam));
+        varianceResult->predictions.reserve(schema->predictions.size());
+        for (size_t j = 0; j < schema->predictions.size(); ++j) {
+            const auto output = impl.predictorBinding.output(*sessionResult, static_cast<int>(j));
+            if (!output) {
+                continue;
             }
+            const auto view = output->view<float>();
+            Co::InputParameterInfo inputParam{schema->predictions[j]};
+            inputParam.interval = frameWidth;
+            inputParam.values.assign(view.begin(), view.end());
+            varianceResult->predictions.emplace_back(std::move(inputParam));
         }
 
         const auto expectedCount = schema->predictions.size();
@@ -509,7 +549,12 @@ namespace ds {
                 stdc::formatN("predicted parameter count mismatch: expected %1, got %2",
                               expectedCount, actualCount));
         }
-        impl.result = varianceResult;
+        // Sessions can run concurrently, only publishing the result is exclusive
+        lock.unlock();
+        {
+            std::unique_lock<std::shared_mutex> resultLock(impl.mutex);
+            impl.result = varianceResult;
+        }
 
         setState(Idle);
         return varianceResult;
@@ -14,6 +14,7 @@
 #include <dsinfer/Api/Inferences/Vocoder/1/VocoderApiL1.h>
 
 #include <inferutil/Driver.h>
+#include <inferutil/SessionBinding.h>
 
 namespace ds {
 
@@ -36,11 +37,24 @@ namespace ds {
         return genericConfig.as<Vo::VocoderConfiguration>();
     }
 
+    // The ports of the vocoder model by binding index
+    enum VocoderInput {
+        VI_Mel,
+        VI_F0,
+        VI_Count,
+    };
+
+    enum VocoderOutput {
+        VO_Waveform,
+        VO_Count,
+    };
+
     class VocoderInference::Impl {
     public:
         srt::NO<Vo::VocoderResult> result;
         srt::NO<InferenceDriver> driver;
         srt::NO<InferenceSession> session;
+        inferutil::SessionBinding binding;
         mutable std::shared_mutex mutex;
     };
 
@@ -87,12 +101,19 @@ namespace ds {
 
         // Open vocoder session
         impl.session = impl.driver->createSession();
+        impl.binding.reset();
         auto sessionOpenArgs = srt::NO<Onnx::SessionOpenArgs>::create();
         sessionOpenArgs->useCpu = false;
         if (auto res = impl.session->open(config->model, sessionOpenArgs); !res) {
             setState(Failed);
             return res;
         }
+        std::vector<std::string> inputs(VI_Count);
+        inputs[VI_Mel] = "mel";
+        inputs[VI_F0] = "f0";
+        std::vector<std::string> outputs(VO_Count);
+        outputs[VO_Waveform] = "waveform";
+        impl.binding.create(*impl.session, std::move(inputs), std::move(outputs));
 
         return srt::Expected<void>();
     }
@@ -134,19 +155,16 @@ namespace ds {
         const auto vocoderInput = input.as<Vo::VocoderStartInput>();
         // ...
 
-        auto sessionInput = srt::NO<Onnx::SessionStartInput>::create();
-        sessionInput->inputs["mel"] = vocoderInput->mel;
-        sessionInput->inputs["f0"] = vocoderInput->f0;
-
-        constexpr const char *outParamWaveform = "waveform";
-        sessionInput->outputs.emplace(outParamWaveform);
-
-        std::unique_lock<std::shared_mutex> lock(impl.mutex);
+        std::shared_lock<std::shared_mutex> lock(impl.mutex);
         if (!impl.session || !impl.session->isOpen()) {
             setState(Failed);
             return srt::Error(srt::Error::SessionError, "vocoder session is not initialized");
         }
 
+        auto sessionInput = impl.binding.createInput();
+        impl.binding.setInput(*sessionInput, VI_Mel, vocoderInput->mel);
+        impl.binding.setInput(*sessionInput, VI_F0, vocoderInput->f0);
+
         srt::NO<srt::TaskResult> sessionTaskResult;
         auto sessionExp = impl.session->start(sessionInput);
         if (!sessionExp) {
@@ -168,9 +186,7 @@ namespace ds {
             return srt::Error(srt::Error::InvalidArgument, "invalid result API name");
         }
         auto sessionResult = sessionTaskResult.as<Onnx::SessionResult>();
-        if (auto it_waveform = sessionResult->outputs.find(outParamWaveform);
-            it_waveform != sessionResult->outputs.end()) {
-            const auto &waveformTensor = it_waveform->second;
+        if (const auto waveformTensor = impl.binding.output(*sessionResult, VO_Waveform)) {
             const auto size = waveformTensor->byteSize();
             vocoderResult->audioData.resize(size);
             if (auto waveformBuffer = waveformTensor->rawData()) {
@@ -180,7 +196,12 @@ namespace ds {
             setState(Failed);
             return srt::Error(srt::Error::SessionError, "invalid result output");
         }
-        impl.result = vocoderResult;
+        // Sessions can run concurrently, only publishing the result is exclusive
+        lock.unlock();
+        {
+            std::unique_lock<std::shared_mutex> resultLock(impl.mutex);
+            impl.result = vocoderResult;
+        }
 
         setState(Idle);
         return vocoderResult;
@@ -0,0 +1,96 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <dsinfer/Core/Float16.h>
+#include <dsinfer/Core/Tensor.h>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(test_Float16)
+
+BOOST_AUTO_TEST_CASE(test_Float16Scalar) {
+    using ds::Float16;
+
+    BOOST_CHECK_EQUAL(Float16(0.0f).bits, 0x0000);
+    BOOST_CHECK_EQUAL(Float16(-0.0f).bits, 0x8000);
+    BOOST_CHECK_EQUAL(Float16(1.0f).bits, 0x3C00);
+    BOOST_CHECK_EQUAL(Float16(-2.0f).bits, 0xC000);
+    BOOST_CHECK_EQUAL(Float16(65504.0f).bits, 0x7BFF);
+
+    // Overflow, infinity and NaN
+    BOOST_CHECK_EQUAL(Float16(65520.0f).bits, 0x7C00);
+    BOOST_CHECK_EQUAL(Float16(std::numeric_limits<float>::infinity()).bits, 0x7C00);
+    BOOST_CHECK(std::isnan(float(Float16(std::numeric_limits<float>::quiet_NaN()))));
+
+    // Ties round to even: 1 + 2^-11 is halfway between 1 and 1 + 2^-10
+    BOOST_CHECK_EQUAL(Float16(1.0f + std::ldexp(1.0f, -11)).bits, 0x3C00);
+    BOOST_CHECK_EQUAL(Float16(1.0f + 3 * std::ldexp(1.0f, -11)).bits, 0x3C02);
+
+    // Subnormals
+    BOOST_CHECK_EQUAL(Float16(std::ldexp(1.0f, -24)).bits, 0x0001);
+    BOOST_CHECK_EQUAL(Float16(std::ldexp(1.0f, -25)).bits, 0x0000);
+    BOOST_CHECK_EQUAL(float(Float16::fromBits(0x03FF)), 1023 * std::ldexp(1.0f, -24));
+
+    // Every finite half converts back to itself
+    for (uint32_t bits = 0; bits < 0x10000; ++bits) {
+        auto h = Float16::fromBits(uint16_t(bits));
+        if ((bits & 0x7C00) == 0x7C00) {
+            continue;
+        }
+        BOOST_CHECK_EQUAL(Float16(float(h)).bits, h.bits);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_BFloat16Scalar) {
+    using ds::BFloat16;
+
+    BOOST_CHECK_EQUAL(BFloat16(1.0f).bits, 0x3F80);
+    BOOST_CHECK_EQUAL(float(BFloat16::fromBits(0xC000)), -2.0f);
+
+    // Ties round to even
+    BOOST_CHECK_EQUAL(BFloat16(1.0f + std::ldexp(1.0f, -8)).bits, 0x3F80);
+    BOOST_CHECK_EQUAL(BFloat16(1.0f + 3 * std::ldexp(1.0f, -8)).bits, 0x3F82);
+
+    BOOST_CHECK(std::isnan(float(BFloat16(std::numeric_limits<float>::quiet_NaN()))));
+}
+
+BOOST_AUTO_TEST_CASE(test_BulkConversion) {
+    // Not a multiple of the vector width, so that the scalar tail runs as well
+    std::vector<float> values(37);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = (float(i) - 18.0f) * 0.37f;
+    }
+
+    std::vector<ds::Float16> halves(values.size());
+    ds::convertFloatToFloat16(values.data(), halves.data(), values.size());
+    std::vector<float> floats(values.size());
+    ds::convertFloat16ToFloat(halves.data(), floats.data(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        BOOST_CHECK_EQUAL(halves[i].bits, ds::Float16(values[i]).bits);
+        BOOST_CHECK_EQUAL(floats[i], float(ds::Float16(values[i])));
+    }
+
+    std::vector<ds::BFloat16> brains(values.size());
+    ds::convertFloatToBFloat16(values.data(), brains.data(), values.size());
+    ds::convertBFloat16ToFloat(brains.data(), floats.data(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        BOOST_CHECK_EQUAL(brains[i].bits, ds::BFloat16(values[i]).bits);
+        BOOST_CHECK_EQUAL(floats[i], float(ds::BFloat16(values[i])));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_Float16Tensor) {
+    auto exp = ds::Tensor::createFilled<ds::Float16>({2, 3}, ds::Float16(0.5f));
+    BOOST_REQUIRE(static_cast<bool>(exp));
+    auto tensor = exp.take();
+    BOOST_CHECK_EQUAL(tensor->dataType(), ds::ITensor::Float16);
+    BOOST_CHECK_EQUAL(tensor->elementSize(), 2);
+    BOOST_CHECK_EQUAL(tensor->byteSize(), 12);
+    BOOST_CHECK(tensor->data<float>() == nullptr);
+    for (const auto &value : tensor->view<ds::Float16>()) {
+        BOOST_CHECK_EQUAL(float(value), 0.5f);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,62 @@
+#include <cstdint>
+#include <vector>
+
+#include <dsinfer/Core/Tensor.h>
+#include <dsinfer/Core/TensorView.h>
+
+#include <boost/test/unit_test.hpp>
+
+using ds::ITensor;
+using ds::Tensor;
+
+BOOST_AUTO_TEST_SUITE(test_Tensor)
+
+BOOST_AUTO_TEST_CASE(test_CloneSharesBuffer) {
+    auto tensor = Tensor::createFilled<float>({2, 4}, 1.0f).take();
+    BOOST_CHECK(!tensor->isShared());
+
+    auto copy = tensor->clone().as<Tensor>();
+    BOOST_CHECK(tensor->isShared());
+    BOOST_CHECK(copy->isShared());
+    BOOST_CHECK_EQUAL(copy->rawData(), tensor->rawData());
+
+    // Reading does not detach
+    BOOST_CHECK_EQUAL(copy->view<float>()[7], 1.0f);
+    BOOST_CHECK_EQUAL(copy->rawData(), tensor->rawData());
+}
+
+BOOST_AUTO_TEST_CASE(test_CopyOnWrite) {
+    auto tensor = Tensor::createFilled<float>({2, 4}, 1.0f).take();
+    auto copy = tensor->clone().as<Tensor>();
+    auto data = tensor->rawData();
+
+    // The writer takes a copy, the other keeps the old buffer
+    copy->mutableData<float>()[0] = 2.0f;
+    BOOST_CHECK_NE(copy->rawData(), data);
+    BOOST_CHECK_EQUAL(tensor->rawData(), data);
+    BOOST_CHECK_EQUAL(tensor->view<float>()[0], 1.0f);
+    BOOST_CHECK_EQUAL(copy->view<float>()[0], 2.0f);
+    BOOST_CHECK_EQUAL(copy->view<float>()[7], 1.0f);
+    BOOST_CHECK(!tensor->isShared());
+    BOOST_CHECK(!copy->isShared());
+
+    // A sole owner writes in place
+    tensor->mutableData<float>()[1] = 3.0f;
+    BOOST_CHECK_EQUAL(tensor->rawData(), data);
+}
+
+BOOST_AUTO_TEST_CASE(test_CloneWholeView) {
+    auto tensor = Tensor::createFilled<int64_t>({3, 2}, 5).take();
+    auto view = ds::TensorView::create(tensor).take();
+
+    auto copy = view->clone();
+    BOOST_REQUIRE(copy);
+    BOOST_CHECK_EQUAL(copy->rawData(), tensor->rawData());
+
+    // Writing through the view leaves the clone alone
+    reinterpret_cast<int64_t *>(view->mutableRawData())[0] = 6;
+    BOOST_CHECK_EQUAL(tensor->view<int64_t>()[0], 6);
+    BOOST_CHECK_EQUAL(copy->view<int64_t>()[0], 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,135 @@
+#include <cstdint>
+#include <vector>
+
+#include <dsinfer/Core/Tensor.h>
+#include <dsinfer/Core/TensorBufferPool.h>
+
+#include <boost/test/unit_test.hpp>
+
+using ds::TensorBufferPool;
+
+BOOST_AUTO_TEST_SUITE(test_TensorBufferPool)
+
+BOOST_AUTO_TEST_CASE(test_ReuseWithinSizeClass) {
+    TensorBufferPool::trim();
+
+    auto first = TensorBufferPool::allocate(1000);
+    BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(first) % TensorBufferPool::ALIGNMENT, 0);
+    TensorBufferPool::deallocate(first, 1000);
+
+    // 1000 and 1010 bytes both round up to the 1024-byte class
+    auto stats = TensorBufferPool::statistics();
+    auto hits = stats.hits;
+    auto second = TensorBufferPool::allocate(1010);
+    BOOST_CHECK_EQUAL(second, first);
+    BOOST_CHECK_EQUAL(TensorBufferPool::statistics().hits, hits + 1);
+
+    // A size of another class does not take it
+    TensorBufferPool::deallocate(second, 1010);
+    auto third = TensorBufferPool::allocate(2000);
+    BOOST_CHECK_NE(third, first);
+    TensorBufferPool::deallocate(third, 2000);
+
+    BOOST_CHECK(TensorBufferPool::trim() >= 1024 + 2048);
+    BOOST_CHECK_EQUAL(TensorBufferPool::statistics().cachedBytes, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_Capacity) {
+    TensorBufferPool::trim();
+    auto oldCapacity = TensorBufferPool::capacity();
+
+    TensorBufferPool::setCapacity(4096);
+    std::vector<void *> blocks;
+    for (int i = 0; i < 8; ++i) {
+        blocks.push_back(TensorBufferPool::allocate(1024));
+    }
+    for (auto block : blocks) {
+        TensorBufferPool::deallocate(block, 1024);
+    }
+    BOOST_CHECK_EQUAL(TensorBufferPool::statistics().cachedBytes, 4096);
+
+    TensorBufferPool::setCapacity(1024);
+    BOOST_CHECK_EQUAL(TensorBufferPool::statistics().cachedBytes, 1024);
+
+    TensorBufferPool::setCapacity(oldCapacity);
+    TensorBufferPool::trim();
+}
+
+BOOST_AUTO_TEST_CASE(test_TensorRecycling) {
+    TensorBufferPool::trim();
+
+    const std::byte *data;
+    {
+        auto exp = ds::Tensor::createFilled<float>({16, 16}, 1.0f);
+        BOOST_REQUIRE(static_cast<bool>(exp));
+        data = exp.get()->rawData();
+    }
+    BOOST_CHECK_EQUAL(TensorBufferPool::statistics().cachedBytes, 1024);
+
+    // The buffer of the released tensor is reused, and zero-filled again
+    auto exp = ds::Tensor::create(ds::ITensor::Float, {256});
+    BOOST_REQUIRE(static_cast<bool>(exp));
+    auto tensor = exp.take();
+    BOOST_CHECK_EQUAL(tensor->rawData(), data);
+    for (auto value : tensor->view<float>()) {
+        BOOST_CHECK_EQUAL(value, 0.0f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_UninitializedTensor) {
+    TensorBufferPool::trim();
+
+    const std::byte *data;
+    {
+        auto exp = ds::Tensor::createFilled<int64_t>({4, 32}, 42);
+        BOOST_REQUIRE(static_cast<bool>(exp));
+        data = exp.get()->rawData();
+        BOOST_CHECK_EQUAL(exp.get()->view<int64_t>()[127], 42);
+    }
+
+    // The buffer is taken as it is, with the same shape checks as create()
+    auto exp = ds::Tensor::createUninitialized(ds::ITensor::Float, {2, 128});
+    BOOST_REQUIRE(static_cast<bool>(exp));
+    auto tensor = exp.take();
+    BOOST_CHECK_EQUAL(tensor->rawData(), data);
+    BOOST_CHECK_EQUAL(tensor->byteSize(), 1024);
+    BOOST_CHECK(!ds::Tensor::createUninitialized(ds::ITensor::Float, {2, 0}));
+}
+
+BOOST_AUTO_TEST_CASE(test_ContainerZeroFill) {
+    TensorBufferPool::trim();
+
+    {
+        ds::Tensor::Container dirty(1024, std::byte{0xff});
+    }
+
+    // Sizing a container still value-initializes, even when the buffer is reused
+    ds::Tensor::Container container(1024);
+    for (auto byte : container) {
+        BOOST_CHECK_EQUAL(static_cast<int>(byte), 0);
+    }
+    container.assign(1024, std::byte{0xff});
+    container.resize(512);
+    container.resize(1024);
+    BOOST_CHECK_EQUAL(static_cast<int>(container[1023]), 0);
+
+    // Copies of an uninitialized container value-initialize again
+    ds::Tensor::Container uninitialized(
+        16, ds::Tensor::Container::allocator_type::uninitialized());
+    ds::Tensor::Container copy(uninitialized);
+    copy.assign(16, std::byte{0xff});
+    copy.resize(8);
+    copy.resize(16);
+    BOOST_CHECK_EQUAL(static_cast<int>(copy[15]), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_TensorAlignment) {
+    auto exp = ds::Tensor::create(ds::ITensor::Float, {3, 7});
+    BOOST_REQUIRE(static_cast<bool>(exp));
+    auto tensor = exp.take();
+    BOOST_CHECK(tensor->alignment() >= ds::Tensor::ALIGNMENT);
+    BOOST_CHECK(tensor->isAligned(ds::Tensor::ALIGNMENT));
+    BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(tensor->rawData()) % ds::Tensor::ALIGNMENT, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
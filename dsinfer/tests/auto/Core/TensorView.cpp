@@ -0,0 +1,99 @@
+#include <cstdint>
+#include <vector>
+
+#include <dsinfer/Core/Tensor.h>
+#include <dsinfer/Core/TensorView.h>
+
+#include <boost/test/unit_test.hpp>
+
+using ds::ITensor;
+using ds::Tensor;
+using ds::TensorView;
+
+static srt::NO<Tensor> createSequence(const std::vector<int64_t> &shape) {
+    auto tensor = Tensor::create(ITensor::Int64, shape).take();
+    auto data = reinterpret_cast<int64_t *>(tensor->mutableRawData());
+    for (size_t i = 0; i < tensor->elementCount(); ++i) {
+        data[i] = static_cast<int64_t>(i);
+    }
+    return tensor;
+}
+
+BOOST_AUTO_TEST_SUITE(test_TensorView)
+
+BOOST_AUTO_TEST_CASE(test_ContiguousSlice) {
+    auto tensor = createSequence({4, 3});
+    auto view = TensorView::create(tensor).take();
+    BOOST_CHECK(view->isContiguous());
+    BOOST_CHECK(view->strides() == std::vector<int64_t>({3, 1}));
+
+    // Rows 1 and 2 share the buffer of the tensor
+    auto rows = view->slice(0, 1, 3).take();
+    BOOST_CHECK(rows->isContiguous());
+    BOOST_CHECK(rows->shape() == std::vector<int64_t>({2, 3}));
+    BOOST_CHECK_EQUAL(rows->offset(), 3);
+    BOOST_CHECK_EQUAL(rows->byteSize(), 6 * sizeof(int64_t));
+    BOOST_CHECK_EQUAL(rows->rawData(), tensor->rawData() + 3 * sizeof(int64_t));
+
+    auto values = rows->view<int64_t>();
+    BOOST_REQUIRE_EQUAL(values.size(), 6);
+    BOOST_CHECK_EQUAL(values[0], 3);
+    BOOST_CHECK_EQUAL(values[5], 8);
+
+    // Writes go to the tensor
+    reinterpret_cast<int64_t *>(rows->mutableRawData())[0] = -1;
+    BOOST_CHECK_EQUAL(tensor->view<int64_t>()[3], -1);
+}
+
+BOOST_AUTO_TEST_CASE(test_StridedSlice) {
+    auto tensor = createSequence({2, 3, 4});
+    auto view = TensorView::create(tensor).take();
+
+    // Columns 1 and 2 of the last axis are not contiguous
+    auto columns = view->slice(2, 1, -1).take();
+    BOOST_CHECK(!columns->isContiguous());
+    BOOST_CHECK(columns->shape() == std::vector<int64_t>({2, 3, 2}));
+    BOOST_CHECK(columns->strides() == std::vector<int64_t>({12, 4, 1}));
+    BOOST_CHECK(columns->rawView().empty());
+    BOOST_CHECK(columns->view<int64_t>().empty());
+
+    auto copy = columns->clone();
+    BOOST_REQUIRE(copy);
+    BOOST_CHECK_EQUAL(copy->backend(), Tensor::BACKEND);
+    BOOST_CHECK(copy->isContiguous());
+    std::vector<int64_t> expected;
+    for (int64_t i = 0; i < 6; ++i) {
+        expected.push_back(i * 4 + 1);
+        expected.push_back(i * 4 + 2);
+    }
+    auto values = copy->view<int64_t>();
+    BOOST_CHECK_EQUAL_COLLECTIONS(values.begin(), values.end(), expected.begin(),
+                                  expected.end());
+
+    // A single slice of the middle axis is contiguous again along the last one
+    auto plane = view->slice(1, 2, 3).take()->slice(0, 1, 2).take();
+    BOOST_CHECK(plane->isContiguous());
+    BOOST_CHECK_EQUAL(plane->view<int64_t>()[0], 20);
+}
+
+BOOST_AUTO_TEST_CASE(test_SharedOwnership) {
+    auto tensor = createSequence({8});
+    auto view = TensorView::create(tensor).take()->slice(0, 4, 8).take();
+    auto nested = TensorView::create(view).take();
+    BOOST_CHECK_EQUAL(nested->base(), view->base());
+    BOOST_CHECK_EQUAL(nested->offset(), 4);
+
+    // The view keeps the buffer alive
+    tensor.reset();
+    BOOST_CHECK_EQUAL(nested->view<int64_t>()[3], 7);
+}
+
+BOOST_AUTO_TEST_CASE(test_InvalidSlice) {
+    auto view = TensorView::create(createSequence({4, 3})).take();
+    BOOST_CHECK(!view->slice(2, 0, 1));
+    BOOST_CHECK(!view->slice(0, 2, 2));
+    BOOST_CHECK(!view->slice(0, 0, 5));
+    BOOST_CHECK(!TensorView::create(nullptr));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
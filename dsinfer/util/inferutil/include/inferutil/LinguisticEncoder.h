@@ -9,22 +9,52 @@
 #include <dsinfer/Api/Drivers/Onnx/OnnxDriverApi.h>
 #include <dsinfer/Api/Inferences/Common/1/CommonApiL1.h>
 
+#include <inferutil/SessionBinding.h>
+
 namespace ds::inferutil {
+    /// The input ports of the linguistic encoder. The phoneme mode takes \c ph_dur, and the word
+    /// mode takes \c word_div and \c word_dur.
+    enum LinguisticEncoderInput {
+        LEI_Tokens,
+        LEI_Languages,
+        LEI_PhDur,
+        LEI_WordDiv,
+        LEI_WordDur,
+        LEI_Count,
+    };
+
+    /// The output ports of the linguistic encoder.
+    enum LinguisticEncoderOutput {
+        LEO_EncoderOut,
+        LEO_XMasks,
+        LEO_Count,
+    };
+
+    /// Creates \a binding for an open linguistic encoder session with the ports of \a mode.
+    void createLinguisticEncoderBinding(SessionBinding &binding, InferenceSession &session,
+                                        Api::Common::L1::LinguisticMode mode, bool useLanguageId);
+
     srt::Expected<srt::NO<Api::Onnx::SessionStartInput>>
-        preprocessLinguisticPhoneme(const std::vector<Api::Common::L1::InputWordInfo> &words,
+        preprocessLinguisticPhoneme(const SessionBinding &binding,
+                                    const std::vector<Api::Common::L1::InputWordInfo> &words,
                                     const std::map<std::string, int> &tokens,
                                     const std::map<std::string, int> &languages, bool useLanguageId,
                                     double frameWidth);
 
     srt::Expected<srt::NO<Api::Onnx::SessionStartInput>>
-        preprocessLinguisticWord(const std::vector<Api::Common::L1::InputWordInfo> &words,
+        preprocessLinguisticWord(const SessionBinding &binding,
+                                 const std::vector<Api::Common::L1::InputWordInfo> &words,
                                  const std::map<std::string, int> &tokens,
                                  const std::map<std::string, int> &languages, bool useLanguageId,
                                  double frameWidth);
 
+    /// Runs the linguistic encoder, and sets its outputs into \a out at the ports
+    /// \a encoderOutPort and \a xMasksPort of \a binding. A negative port is not set.
     srt::Expected<void> runEncoder(const srt::NO<InferenceSession> &encoderSession,
-                                   const srt::NO<srt::TaskStartInput> &linguisticInput,
-                                   srt::NO<Api::Onnx::SessionStartInput> &out,
-                                   bool useXMasks = true);
+                                   const SessionBinding &encoderBinding,
+                                   const srt::NO<Api::Onnx::SessionStartInput> &linguisticInput,
+                                   const SessionBinding &binding,
+                                   Api::Onnx::SessionStartInput &out, int encoderOutPort,
+                                   int xMasksPort = -1);
 }
 #endif // DSINFER_INFERUTIL_LINGUISTICENCODER_H
\ No newline at end of file
@@ -0,0 +1,54 @@
+#ifndef DSINFER_INFERUTIL_SESSIONBINDING_H
+#define DSINFER_INFERUTIL_SESSIONBINDING_H
+
+#include <string>
+#include <vector>
+
+#include <dsinfer/Api/Drivers/Onnx/OnnxDriverApi.h>
+#include <dsinfer/Core/Tensor.h>
+#include <dsinfer/Inference/InferenceSession.h>
+
+namespace ds::inferutil {
+    /// SessionBinding - The binding plan of an open session, with the ports of the model
+    /// addressed by the index of the caller instead of by name.
+    ///
+    /// The binding is created once after the session is opened, and its runs fill the input
+    /// slots and read the output slots by port index. On a driver without plans, the same calls
+    /// pass the tensors by name.
+    class SessionBinding {
+    public:
+        SessionBinding() = default;
+        ~SessionBinding() = default;
+
+        SessionBinding(const SessionBinding &) = delete;
+        SessionBinding &operator=(const SessionBinding &) = delete;
+
+        /// Creates the binding of \a session with the port names in the order of the port
+        /// indices. An empty name is a port the model does not take in its configuration, whose
+        /// tensors are dropped.
+        void create(InferenceSession &session, std::vector<std::string> inputs,
+                    std::vector<std::string> outputs);
+
+        /// Drops the binding, which must be done before the session is opened again.
+        void reset();
+
+        /// Creates a start input with an empty slot for every input of the plan.
+        srt::NO<Api::Onnx::SessionStartInput> createInput() const;
+
+        /// Sets the tensor of the input port \a port, replacing the one set before.
+        void setInput(Api::Onnx::SessionStartInput &input, int port,
+                      srt::NO<ITensor> tensor) const;
+
+        /// Returns the tensor of the output port \a port in \a result, or null if missing.
+        srt::NO<ITensor> output(const Api::Onnx::SessionResult &result, int port) const;
+
+    private:
+        std::vector<std::string> _inputs;
+        std::vector<std::string> _outputs;
+        std::vector<int> _inputSlots;
+        std::vector<int> _outputSlots;
+        srt::NO<Api::Onnx::SessionBindingPlan> _plan;
+    };
+}
+
+#endif // DSINFER_INFERUTIL_SESSIONBINDING_H
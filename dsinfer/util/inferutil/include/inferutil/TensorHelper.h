@@ -16,7 +16,7 @@ namespace ds::inferutil {
         static srt::Expected<TensorHelper> createFor1DArray(size_t size) {
             TensorHelper helper;
             std::vector<int64_t> shape{1, static_cast<int64_t>(size)};
-            auto exp = Tensor::create(tensor_traits<T>::data_type, shape);
+            auto exp = Tensor::createUninitialized(tensor_traits<T>::data_type, shape);
             if (!exp) {
                 return exp.takeError();
             }
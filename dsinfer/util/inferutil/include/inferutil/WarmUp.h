@@ -0,0 +1,21 @@
+#ifndef DSINFER_INFERUTIL_WARMUP_H
+#define DSINFER_INFERUTIL_WARMUP_H
+
+#include <vector>
+
+#include <synthrt/Support/Expected.h>
+#include <synthrt/SVS/Inference.h>
+#include <synthrt/SVS/SingerContrib.h>
+
+namespace ds::inferutil {
+    /// Creates and initializes the inferences imported by the singer in parallel, which opens
+    /// their sessions, then runs every open session once with synthetic inputs of the given
+    /// length through the inference driver.
+    ///
+    /// The returned inferences keep the sessions loaded, so they should be kept and used for
+    /// the later requests.
+    srt::Expected<std::vector<srt::NO<srt::Inference>>> warmUpSinger(const srt::SingerSpec *singer,
+                                                                     int64_t length = 256);
+}
+
+#endif // DSINFER_INFERUTIL_WARMUP_H
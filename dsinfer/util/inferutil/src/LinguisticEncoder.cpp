@@ -13,57 +13,76 @@ namespace ds::inferutil {
 
     namespace Co = Api::Common::L1;
 
+    void createLinguisticEncoderBinding(SessionBinding &binding, InferenceSession &session,
+                                        Co::LinguisticMode mode, bool useLanguageId) {
+        std::vector<std::string> inputs(LEI_Count);
+        inputs[LEI_Tokens] = "tokens";
+        if (useLanguageId) {
+            inputs[LEI_Languages] = "languages";
+        }
+        if (mode == Co::LM_Word) {
+            inputs[LEI_WordDiv] = "word_div";
+            inputs[LEI_WordDur] = "word_dur";
+        } else {
+            inputs[LEI_PhDur] = "ph_dur";
+        }
+
+        std::vector<std::string> outputs(LEO_Count);
+        outputs[LEO_EncoderOut] = "encoder_out";
+        outputs[LEO_XMasks] = "x_masks";
+        binding.create(session, std::move(inputs), std::move(outputs));
+    }
+
     srt::Expected<srt::NO<Api::Onnx::SessionStartInput>>
-        preprocessLinguisticPhoneme(const std::vector<Api::Common::L1::InputWordInfo> &words,
+        preprocessLinguisticPhoneme(const SessionBinding &binding,
+                                    const std::vector<Api::Common::L1::InputWordInfo> &words,
                                     const std::map<std::string, int> &tokens,
                                     const std::map<std::string, int> &languages, bool useLanguageId,
                                     double frameWidth) {
 
-        auto sessionInput = srt::NO<Api::Onnx::SessionStartInput>::create();
+        auto sessionInput = binding.createInput();
 
         if (auto exp = preprocessPhonemeTokens(words, tokens); exp) {
-            sessionInput->inputs.emplace("tokens", exp.take());
+            binding.setInput(*sessionInput, LEI_Tokens, exp.take());
         } else {
             return exp.takeError();
         }
 
         if (useLanguageId) {
             if (auto exp = preprocessPhonemeLanguages(words, languages); exp) {
-                sessionInput->inputs.emplace("languages", exp.take());
+                binding.setInput(*sessionInput, LEI_Languages, exp.take());
             } else {
                 return exp.takeError();
             }
         }
 
         if (auto exp = preprocessPhonemeDurations(words, frameWidth); exp) {
-            sessionInput->inputs.emplace("ph_dur", exp.take());
+            binding.setInput(*sessionInput, LEI_PhDur, exp.take());
         } else {
             return exp.takeError();
         }
 
-        // session output names
-        sessionInput->outputs = {"encoder_out", "x_masks"};
-
         return sessionInput;
     }
 
     srt::Expected<srt::NO<Api::Onnx::SessionStartInput>>
-        preprocessLinguisticWord(const std::vector<Api::Common::L1::InputWordInfo> &words,
+        preprocessLinguisticWord(const SessionBinding &binding,
+                                 const std::vector<Api::Common::L1::InputWordInfo> &words,
                                  const std::map<std::string, int> &tokens,
                                  const std::map<std::string, int> &languages, bool useLanguageId,
                                  double frameWidth) {
 
-        auto sessionInput = srt::NO<Api::Onnx::SessionStartInput>::create();
+        auto sessionInput = binding.createInput();
 
         if (auto exp = preprocessPhonemeTokens(words, tokens); exp) {
-            sessionInput->inputs.emplace("tokens", exp.take());
+            binding.setInput(*sessionInput, LEI_Tokens, exp.take());
         } else {
             return exp.takeError();
         }
 
         if (useLanguageId) {
             if (auto exp = preprocessPhonemeLanguages(words, languages); exp) {
-                sessionInput->inputs.emplace("languages", exp.take());
+                binding.setInput(*sessionInput, LEI_Languages, exp.take());
             } else {
                 return exp.takeError();
             }
@@ -75,7 +94,7 @@ namespace ds::inferutil {
             for (const auto &word : words) {
                 wordDiv.writeUnchecked(word.phones.size());
             }
-            sessionInput->inputs.emplace("word_div", wordDiv.take());
+            binding.setInput(*sessionInput, LEI_WordDiv, wordDiv.take());
         } else {
             return exp.takeError();
         }
@@ -91,24 +110,23 @@ namespace ds::inferutil {
                 wordDurFrames.writeUnchecked(currFrames - prevFrames);
                 prevFrames = currFrames;
             }
-            sessionInput->inputs.emplace("word_dur", wordDurFrames.take());
+            binding.setInput(*sessionInput, LEI_WordDur, wordDurFrames.take());
         } else {
             return exp.takeError();
         }
 
-        // session output names
-        sessionInput->outputs = {"encoder_out", "x_masks"};
-
         return sessionInput;
     }
+
     srt::Expected<void> runEncoder(const srt::NO<InferenceSession> &encoderSession,
-                                   const srt::NO<srt::TaskStartInput> &linguisticInput,
-                                   srt::NO<Api::Onnx::SessionStartInput> &out,
-                                   bool useXMasks) {
+                                   const SessionBinding &encoderBinding,
+                                   const srt::NO<Api::Onnx::SessionStartInput> &linguisticInput,
+                                   const SessionBinding &binding,
+                                   Api::Onnx::SessionStartInput &out, int encoderOutPort,
+                                   int xMasksPort) {
         // Assuming encoderSession is already opened
         srt::NO<srt::TaskResult> sessionTaskResult;
-        auto sessionExp = encoderSession->start(linguisticInput);
-        if (!sessionExp) {
+        if (auto sessionExp = encoderSession->start(linguisticInput); !sessionExp) {
             return sessionExp.takeError();
         } else {
             sessionTaskResult = sessionExp.take();
@@ -122,14 +140,14 @@ namespace ds::inferutil {
         if (sessionTaskResult->objectName() != Api::Onnx::API_NAME) {
             return srt::Error(srt::Error::InvalidArgument, "invalid result API name");
         }
-        auto encoderResult = sessionTaskResult.as<Api::Onnx::SessionResult>();
-        for (auto &&[name, value] : encoderResult->outputs) {
-            if (name == "encoder_out") {
-                out->inputs.emplace("encoder_out", std::move(value));
-            } else if (useXMasks && name == "x_masks") {
-                out->inputs.emplace("x_masks", std::move(value));
-            }
+        const auto &encoderResult = *sessionTaskResult.as<Api::Onnx::SessionResult>();
+        if (encoderOutPort >= 0) {
+            binding.setInput(out, encoderOutPort,
+                             encoderBinding.output(encoderResult, LEO_EncoderOut));
+        }
+        if (xMasksPort >= 0) {
+            binding.setInput(out, xMasksPort, encoderBinding.output(encoderResult, LEO_XMasks));
         }
         return srt::Expected<void>();
     }
-}
\ No newline at end of file
+}
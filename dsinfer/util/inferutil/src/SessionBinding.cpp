@@ -0,0 +1,93 @@
+#include "inferutil/SessionBinding.h"
+
+#include <utility>
+
+namespace ds::inferutil {
+
+    // Maps each port to its slot in the plan, skipping the ports the model does not take.
+    static std::vector<int> slotsOf(const std::vector<std::string> &ports,
+                                    std::vector<std::string> &names) {
+        std::vector<int> slots(ports.size(), -1);
+        for (size_t i = 0; i < ports.size(); ++i) {
+            if (!ports[i].empty()) {
+                slots[i] = static_cast<int>(names.size());
+                names.push_back(ports[i]);
+            }
+        }
+        return slots;
+    }
+
+    void SessionBinding::create(InferenceSession &session, std::vector<std::string> inputs,
+                                std::vector<std::string> outputs) {
+        _inputs = std::move(inputs);
+        _outputs = std::move(outputs);
+
+        std::vector<std::string> inputNames;
+        std::vector<std::string> outputNames;
+        _inputSlots = slotsOf(_inputs, inputNames);
+        _outputSlots = slotsOf(_outputs, outputNames);
+
+        // Without a plan, the runs by name report the ports that do not match the model
+        _plan.reset();
+        auto exp = session.createBindingPlan(inputNames, outputNames);
+        if (!exp) {
+            return;
+        }
+        auto plan = exp.take();
+        if (plan && plan->objectName() == Api::Onnx::API_NAME) {
+            _plan = plan.as<Api::Onnx::SessionBindingPlan>();
+        }
+    }
+
+    void SessionBinding::reset() {
+        _inputs.clear();
+        _outputs.clear();
+        _inputSlots.clear();
+        _outputSlots.clear();
+        _plan.reset();
+    }
+
+    srt::NO<Api::Onnx::SessionStartInput> SessionBinding::createInput() const {
+        auto input = srt::NO<Api::Onnx::SessionStartInput>::create();
+        if (_plan) {
+            input->bindingPlan = _plan;
+            input->inputSlots.resize(_plan->inputs.size());
+            return input;
+        }
+        for (const auto &name : _outputs) {
+            if (!name.empty()) {
+                input->outputs.insert(name);
+            }
+        }
+        return input;
+    }
+
+    void SessionBinding::setInput(Api::Onnx::SessionStartInput &input, int port,
+                                  srt::NO<ITensor> tensor) const {
+        const auto slot = _inputSlots[port];
+        if (slot < 0) {
+            return;
+        }
+        if (_plan) {
+            input.inputSlots[slot] = std::move(tensor);
+        } else {
+            input.inputs[_inputs[port]] = std::move(tensor);
+        }
+    }
+
+    srt::NO<ITensor> SessionBinding::output(const Api::Onnx::SessionResult &result,
+                                            int port) const {
+        const auto slot = _outputSlots[port];
+        if (slot < 0) {
+            return {};
+        }
+        if (_plan) {
+            return static_cast<size_t>(slot) < result.outputSlots.size()
+                       ? result.outputSlots[slot]
+                       : srt::NO<ITensor>();
+        }
+        auto it = result.outputs.find(_outputs[port]);
+        return it != result.outputs.end() ? it->second : srt::NO<ITensor>();
+    }
+
+}
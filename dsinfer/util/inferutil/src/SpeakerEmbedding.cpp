@@ -1,5 +1,6 @@
 #include <inferutil/SpeakerEmbedding.h>
 
+#include <algorithm>
 #include <fstream>
 #include <utility>
 
@@ -45,7 +46,8 @@ namespace ds::inferutil {
         double frameWidth, int64_t targetLength) {
 
         std::vector<int64_t> shape = {1, targetLength, hiddenSize};
-        if (auto exp = Tensor::create(ITensor::Float, shape); exp) {
+        // Every element is written by the first speaker, or zeroed if there is none
+        if (auto exp = Tensor::createUninitialized(ITensor::Float, shape); exp) {
             // get tensor buffer
             auto tensor = exp.take();
             auto buffer = tensor->mutableData<float>();
@@ -54,6 +56,7 @@ namespace ds::inferutil {
             }
 
             // mix speaker embedding
+            bool first = true;
             for (const auto &speaker : std::as_const(speakers)) {
                 if (auto it_speaker = embMap.find(speaker.name); it_speaker != embMap.end()) {
                     const auto &embedding = it_speaker->second;
@@ -64,6 +67,18 @@ namespace ds::inferutil {
                     }
                     auto resampled = resample(speaker.proportions, speaker.interval, frameWidth,
                                               targetLength, true);
+                    if (first) {
+                        for (size_t i = 0; i < resampled.size(); ++i) {
+                            for (size_t j = 0; j < embedding.size(); ++j) {
+                                buffer[i * embedding.size() + j] =
+                                    static_cast<float>(resampled[i]) * embedding[j];
+                            }
+                        }
+                        std::fill(buffer + resampled.size() * embedding.size(),
+                                  buffer + tensor->elementCount(), 0.0f);
+                        first = false;
+                        continue;
+                    }
                     for (size_t i = 0; i < resampled.size(); ++i) {
                         for (size_t j = 0; j < embedding.size(); ++j) {
                             float &val = buffer[i * embedding.size() + j];
@@ -75,6 +90,9 @@ namespace ds::inferutil {
                                       "invalid speaker name: " + speaker.name);
                 }
             }
+            if (first) {
+                std::fill(buffer, buffer + tensor->elementCount(), 0.0f);
+            }
             return tensor;
         } else {
             return exp.takeError();
@@ -0,0 +1,137 @@
+#include "inferutil/WarmUp.h"
+
+#include <future>
+
+#include <synthrt/SVS/InferenceContrib.h>
+
+#include <dsinfer/Api/Drivers/Onnx/OnnxDriverApi.h>
+#include <dsinfer/Api/Inferences/Acoustic/1/AcousticApiL1.h>
+#include <dsinfer/Api/Inferences/Duration/1/DurationApiL1.h>
+#include <dsinfer/Api/Inferences/Pitch/1/PitchApiL1.h>
+#include <dsinfer/Api/Inferences/Variance/1/VarianceApiL1.h>
+#include <dsinfer/Api/Inferences/Vocoder/1/VocoderApiL1.h>
+
+#include "inferutil/Driver.h"
+
+namespace ds::inferutil {
+
+    namespace Ac = Api::Acoustic::L1;
+    namespace Dur = Api::Duration::L1;
+    namespace Pit = Api::Pitch::L1;
+    namespace Var = Api::Variance::L1;
+    namespace Vo = Api::Vocoder::L1;
+
+    template <class RuntimeOptions, class InitArgs>
+    static srt::Expected<srt::NO<srt::Inference>> createInference(const srt::SingerImport &imp) {
+        auto exp = imp.inference()->createInference(imp.options(),
+                                                    srt::NO<RuntimeOptions>::create());
+        if (!exp) {
+            return exp.takeError();
+        }
+        auto inference = exp.take();
+        if (auto res = inference->initialize(srt::NO<InitArgs>::create()); !res) {
+            return res.takeError();
+        }
+        return inference;
+    }
+
+    // The model files the inference of the import opens.
+    static void collectModelPaths(const srt::InferenceSpec *spec,
+                                  std::vector<std::filesystem::path> &paths) {
+        const auto config = spec->configuration();
+        if (!config) {
+            return;
+        }
+        const auto &cls = config->className();
+        if (cls == Ac::API_CLASS) {
+            paths.push_back(config.as<Ac::AcousticConfiguration>()->model);
+        } else if (cls == Dur::API_CLASS) {
+            auto durConfig = config.as<Dur::DurationConfiguration>();
+            paths.push_back(durConfig->encoder);
+            paths.push_back(durConfig->predictor);
+        } else if (cls == Pit::API_CLASS) {
+            auto pitConfig = config.as<Pit::PitchConfiguration>();
+            paths.push_back(pitConfig->encoder);
+            paths.push_back(pitConfig->predictor);
+        } else if (cls == Var::API_CLASS) {
+            auto varConfig = config.as<Var::VarianceConfiguration>();
+            paths.push_back(varConfig->encoder);
+            paths.push_back(varConfig->predictor);
+        } else if (cls == Vo::API_CLASS) {
+            paths.push_back(config.as<Vo::VocoderConfiguration>()->model);
+        }
+    }
+
+    srt::Expected<std::vector<srt::NO<srt::Inference>>> warmUpSinger(const srt::SingerSpec *singer,
+                                                                     int64_t length) {
+        if (!singer) {
+            return srt::Error(srt::Error::InvalidArgument, "singer is nullptr");
+        }
+
+        // Open the sessions of all imports at once
+        std::vector<std::future<srt::Expected<srt::NO<srt::Inference>>>> futures;
+        std::vector<std::filesystem::path> models;
+        for (const auto &imp : singer->imports()) {
+            if (imp.isNull() || !imp.inference()) {
+                continue;
+            }
+            collectModelPaths(imp.inference(), models);
+            const auto &cls = imp.inference()->className();
+            if (cls == Dur::API_CLASS) {
+                futures.push_back(std::async(
+                    std::launch::async,
+                    createInference<Dur::DurationRuntimeOptions, Dur::DurationInitArgs>, imp));
+            } else if (cls == Pit::API_CLASS) {
+                futures.push_back(std::async(
+                    std::launch::async,
+                    createInference<Pit::PitchRuntimeOptions, Pit::PitchInitArgs>, imp));
+            } else if (cls == Var::API_CLASS) {
+                futures.push_back(std::async(
+                    std::launch::async,
+                    createInference<Var::VarianceRuntimeOptions, Var::VarianceInitArgs>, imp));
+            } else if (cls == Ac::API_CLASS) {
+                futures.push_back(std::async(
+                    std::launch::async,
+                    createInference<Ac::AcousticRuntimeOptions, Ac::AcousticInitArgs>, imp));
+            } else if (cls == Vo::API_CLASS) {
+                futures.push_back(std::async(
+                    std::launch::async,
+                    createInference<Vo::VocoderRuntimeOptions, Vo::VocoderInitArgs>, imp));
+            }
+        }
+
+        std::vector<srt::NO<srt::Inference>> inferences;
+        srt::Error error;
+        for (auto &future : futures) {
+            auto exp = future.get();
+            if (!exp) {
+                if (error.ok()) {
+                    error = exp.takeError();
+                }
+                continue;
+            }
+            inferences.push_back(exp.take());
+        }
+        if (!error.ok()) {
+            return error;
+        }
+        if (inferences.empty()) {
+            return inferences;
+        }
+
+        // Dry-run the sessions opened above
+        auto expDriver = getInferenceDriver(inferences.front().get());
+        if (!expDriver) {
+            return expDriver.takeError();
+        }
+        auto warmUpArgs = srt::NO<Api::Onnx::DriverWarmUpArgs>::create();
+        warmUpArgs->length = length;
+        // Only the models of this singer, not those other singers keep open
+        warmUpArgs->models = std::move(models);
+        if (auto res = expDriver.take()->warmUp(warmUpArgs); !res) {
+            return res.takeError();
+        }
+        return inferences;
+    }
+
+}
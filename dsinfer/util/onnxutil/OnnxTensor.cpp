@@ -12,6 +12,10 @@ namespace ds {
                 return sizeof(bool);
             case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
                 return sizeof(int64_t);
+            case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+                return sizeof(Float16);
+            case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+                return sizeof(BFloat16);
             default:
                 return 0;
         }
@@ -25,6 +29,10 @@ namespace ds {
                 return sizeof(int64_t);
             case ITensor::Bool:
                 return sizeof(bool);
+            case ITensor::Float16:
+                return sizeof(Float16);
+            case ITensor::BFloat16:
+                return sizeof(BFloat16);
             default:
                 assert(false && "Unsupported data type");
                 return 0;
@@ -154,6 +162,12 @@ namespace ds {
             case Int64:
                 onnxType = ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64;
                 break;
+            case Float16:
+                onnxType = ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16;
+                break;
+            case BFloat16:
+                onnxType = ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16;
+                break;
             default:
                 return srt::Error(srt::Error::InvalidArgument, "unsupported data type");
         }
@@ -216,6 +230,12 @@ namespace ds {
             case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
                 tensor->_dataType = Int64;
                 break;
+            case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+                tensor->_dataType = Float16;
+                break;
+            case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+                tensor->_dataType = BFloat16;
+                break;
             default:
                 return srt::Error(srt::Error::InvalidArgument, "unsupported data type");
         }
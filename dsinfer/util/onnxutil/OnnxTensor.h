@@ -184,6 +184,7 @@ namespace ds {
                       "sizeof(bool) == 1 does not satisfy");
 
         Tensor::Container data(sizeof(T));
+        *reinterpret_cast<T *>(data.data()) = value;
         stdc::array_view<std::byte> rawView(data.data(), data.size());
 
         return createFromRawView(tensor_traits<T>::data_type,
@@ -1,6 +1,8 @@
 #ifndef SYNTHRT_ITask_P_H
 #define SYNTHRT_ITask_P_H
 
+#include <atomic>
+
 #include <synthrt/Task/ITask.h>
 
 #include "Core/NamedObject_p.h"
@@ -12,7 +14,7 @@ namespace srt {
         inline Impl(ITask *task) : NamedObject::Impl(task) {
         }
 
-        State state = Idle;
+        std::atomic<State> state{Idle};
     };
 
 }